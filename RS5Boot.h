@@ -0,0 +1,134 @@
+// ============================================================================
+// File: RS5Boot.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Boot sequencer, current aware servo soft start and a time
+//              stamped boot timeline
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Boot Sequence
+//
+// Core 0 releases core 1 as soon as the config store is loaded, so the servo
+// start on core 1 runs while core 0 builds the eye presets, checks the program
+// and starts the DMX receiver and telemetry.
+//
+// Hobby servos have no position feedback, so each servo's first pulse is its
+// ServoStartDeg, the rest pose, and the motion engine starts from there; the
+// move to the run targets is ramped by the engine once the run loops start.
+// Servos start one after the other so their inrush currents don't add up, but
+// the next one starts as soon as the servo supply current has dropped below
+// BOOT_SETTLE_CURRENT rather than after a fixed delay. Without a current sense
+// the reading stays low and every servo takes BOOT_SERVO_MIN_MS.
+//
+// Each phase is time stamped against reset. The timeline prints when both
+// cores enter their run loops with boot messages on, and from the console at
+// any time (b), for a console that connects after boot.
+#define BOOT_SERIAL_WAIT_MS   500    // Longest setup() waits for a console with boot messages on
+#define BOOT_SETTLE_CURRENT   400    // SERVO_CURRENT_LOW-HIGH scale, below this the next servo starts
+#define BOOT_SERVO_MIN_MS     20     // Shortest time between two servo starts
+#define BOOT_SERVO_MAX_MS     250    // Longest wait for one servo's current to settle
+
+enum bootPhase {
+  BootSetup,    // setup() entered
+  BootConsole,  // Console connected or waited out
+  BootConfig,   // Config store loaded, core 1 released
+  BootDMX,      // DMX receiver started
+  BootCore0,    // setup() finished
+  BootCore1,    // setup1() started
+  BootPixels,   // Status pixels lit
+  BootMotion,   // Motion engine at the start pose
+  BootServos,   // Last servo started and settled
+  BootRun,      // Both cores in their run loops
+  BootPhases
+};
+
+const char* const bootPhaseName[BootPhases] = { "setup", "console", "config", "dmx", "core 0 ready", "setup1", "pixels", "motion", "servos", "run" };
+
+class BootTimeline {
+public:
+  uint16_t reached;                       // Bit per phase
+  uint16_t started;                       // Bit per servo
+  uint32_t phaseUs[BootPhases];           // time_us_32() the phase was reached
+  uint32_t servoUs[NUM_SERVO_PINS];       // First pulse
+  uint32_t settleUs[NUM_SERVO_PINS];      // Time its current took to settle
+  int peakCurrent[NUM_SERVO_PINS];
+
+public:
+  BootTimeline() {
+    reached = 0;
+    started = 0;
+    for (int i = 0; i < BootPhases; i++) phaseUs[i] = 0;
+    for (int i = 0; i < NUM_SERVO_PINS; i++) {
+      servoUs[i] = 0;
+      settleUs[i] = 0;
+      peakCurrent[i] = 0;
+    }
+  }
+
+public:
+
+  void mark(int phase) {
+    phaseUs[phase] = time_us_32();
+    reached |= 1 << phase;
+  }
+
+  void print() {
+    Serial.printf("Boot timeline, ms since reset:\n");
+    for (int i = 0; i < BootPhases; i++) {
+      if (!(reached & (1 << i))) continue;
+      Serial.printf("  %-13s %7.1f\n", bootPhaseName[i], phaseUs[i] / 1000.0f);
+      if (i != BootMotion) continue;
+      for (int s = 0; s < NUM_SERVO_PINS; s++) {
+        if (!(started & (1 << s))) continue;
+        Serial.printf("  servo %d       %7.1f  settled in %.1fms, peak current %d\n", s, servoUs[s] / 1000.0f, settleUs[s] / 1000.0f, peakCurrent[s]);
+      }
+    }
+    if (reached & (1 << BootRun)) Serial.printf("Boot: %.1fms\n", phaseUs[BootRun] / 1000.0f);
+  }
+};
+
+BootTimeline bootTimeline;
+
+//**********************************************************************************
+// Hooks for the sketch
+
+void bootMark(int phase) {
+  bootTimeline.mark(phase);
+}
+
+// setup(), with boot messages on: waits for the console, but never for long,
+// a prop without a USB host still boots
+void bootWaitConsole() {
+  while (!Serial && millis() < BOOT_SERIAL_WAIT_MS) {
+    delay(1);
+  }
+}
+
+// setup1(), right after servo i's first pulse: returns once the servo supply
+// current has settled, at least BOOT_SERVO_MIN_MS and at most BOOT_SERVO_MAX_MS
+// after the start
+void bootSettle(int i) {
+  uint32_t start = time_us_32();
+  bootTimeline.servoUs[i] = start;
+  bootTimeline.started |= 1 << i;
+  int peak = 0;
+  while (true) {
+    int current = currentNow();
+    if (current > peak) peak = current;
+    uint32_t waited = time_us_32() - start;
+    if (waited >= BOOT_SERVO_MAX_MS * 1000) break;
+    if (waited >= BOOT_SERVO_MIN_MS * 1000 && current < BOOT_SETTLE_CURRENT) break;
+    delay(1);
+  }
+  bootTimeline.settleUs[i] = time_us_32() - start;
+  bootTimeline.peakCurrent[i] = peak;
+}
+
+// Console b
+void bootReport() {
+  bootTimeline.print();
+}
@@ -0,0 +1,360 @@
+// ============================================================================
+// File: RS5Capture.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: DMX show capture, patched channels delta encoded over USB, and
+//              replay of a capture into the DMX frame buffer
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// DMX Capture
+//
+// Console 'x' turns capture on. Core 0 polls dmxFrameCount once per loop()
+// pass and queues one CaptureRecord per frame: the arrival time stamped by
+// dmxFrameArrived() and the patched channels that changed since the last
+// record. The patch is the start code, the servo channels from the DMX
+// address and the two eye channels; a CapturePatch record lists their DMX
+// channel numbers whenever it changes. Every CAPTURE_KEY_PERIOD records, and
+// after a record was dropped, a CaptureKey record carries all of them. The
+// telemetry task sends the records as TelemetryCapture frames, so capture
+// needs no extra task and mixes with other telemetry.
+//
+// extras/tools/dmx_capture.py records the stream to a file, dumps it as CSV
+// and plays it back into the firmware or rs5sim (--replay).
+//
+// DMX Replay
+//
+// The same records sent to the console start a replay. The first CapturePatch
+// stops the DMX receiver; frames are then queued and written into bufferDmx at
+// the captured intervals, REPLAY_LEAD_US after the first one arrived, so USB
+// jitter doesn't reach the show timing. readDMX(), checkDMX() and the latency
+// tracer see them like received frames. A CaptureEnd record, or no record
+// for REPLAY_TIMEOUT_MS, ends the replay and restarts the receiver.
+#ifndef RS5_CAPTURE
+#define RS5_CAPTURE 1
+#endif
+
+#define CAPTURE_CHANNELS_MAX  10   // Start code, NUM_LIC_SERVOS servos, 2 eye channels
+#define CAPTURE_RING_SIZE     64   // Records, power of two, 1.4s of 44Hz DMX
+#define CAPTURE_KEY_PERIOD    44   // Records between key records, about 1s
+#define REPLAY_RING_SIZE      32   // Records, power of two, must hold REPLAY_LEAD_US of frames
+#define REPLAY_LEAD_US        200000
+#define REPLAY_LATE_US        2000   // Applied later than this counts as late
+#define REPLAY_TIMEOUT_MS     10000
+
+enum captureFlags {
+  CaptureKey = 0x01,    // Every patched channel is carried
+  CapturePatch = 0x02,  // data holds the patch, uint16 DMX channel numbers
+  CaptureEnd = 0x04     // Replay only, end of the capture
+};
+
+struct CaptureRecord {
+  uint8_t type;     // TelemetryCapture
+  uint8_t flags;    // captureFlags
+  uint16_t seq;
+  uint32_t timeUs;  // Frame arrival, time_us_32()
+  uint16_t frames;  // Frames received since the previous record, >1 when a loop pass missed some
+  uint16_t mask;    // Bit k set: patch channel k is carried in data, in patch order
+  uint8_t data[CAPTURE_CHANNELS_MAX * 2];
+};
+
+#define CAPTURE_HEADER_SIZE  12
+
+static_assert(sizeof(CaptureRecord) <= TELEMETRY_RECORD_MAX, "CaptureRecord must fit a telemetry frame");
+static_assert(NUM_LIC_SERVOS + 3 <= CAPTURE_CHANNELS_MAX, "DMX patch does not fit a CaptureRecord");
+
+// Bytes of r that go on the wire
+inline uint32_t captureRecordSize(const CaptureRecord& r) {
+  uint32_t n = __builtin_popcount(r.mask);
+  return CAPTURE_HEADER_SIZE + ((r.flags & CapturePatch) ? 2 * n : n);
+}
+
+extern volatile uint8_t bufferDmx[];  // SkullMasterV2.ino
+extern DmxInput dmxInput;
+
+#if RS5_CAPTURE
+
+//**********************************************************************************
+// Capture, core 0 produces, the telemetry task drains
+class DmxCapture {
+public:
+  RecordRing<CaptureRecord, CAPTURE_RING_SIZE> ring;
+  bool active;
+  uint16_t channel[CAPTURE_CHANNELS_MAX];  // Patch, DMX channel numbers
+  uint8_t count;
+  uint8_t last[CAPTURE_CHANNELS_MAX];      // Values in the last record sent
+  uint32_t lastCount;                      // dmxFrameCount at the last record
+  uint16_t sinceKey;
+  bool needPatch;
+  bool needKey;
+
+public:
+  DmxCapture() {
+    active = false;
+    count = 0;
+    lastCount = 0;
+    sinceKey = 0;
+    needPatch = true;
+    needKey = true;
+  }
+
+public:
+
+  void start() {
+    active = true;
+    count = 0;  // Forces a patch record
+    lastCount = dmxFrameCount;
+    needKey = true;
+    telemetry.enable(TelemetryCapture, true);
+  }
+
+  void stop() {
+    active = false;
+    telemetry.enable(TelemetryCapture, false);
+  }
+
+  // Start code, servo channels and eye channels for the current switches
+  void updatePatch() {
+    uint16_t want[CAPTURE_CHANNELS_MAX];
+    uint8_t n = 0;
+    want[n++] = 0;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) want[n++] = i + systemState.getDMXAddress();
+    want[n++] = systemState.startDMXEyes;
+    want[n++] = systemState.startDMXEyes + 1;
+    if (n == count && memcmp(want, channel, n * sizeof(want[0])) == 0) return;
+    memcpy(channel, want, n * sizeof(want[0]));
+    count = n;
+    needPatch = true;
+    needKey = true;
+  }
+
+  // Core 0, once per loop() pass
+  void poll() {
+    if (!active) return;
+    uint32_t frameCount = dmxFrameCount;
+    if (frameCount == lastCount) return;
+    uint32_t at = dmxFrameUs;
+    uint32_t frames = frameCount - lastCount;  // Includes frames a full ring skipped
+
+    updatePatch();
+    if (needPatch) {
+      CaptureRecord* p = ring.claim();
+      if (p == NULL) return;  // Sent with the next frame
+      p->type = TelemetryCapture;
+      p->flags = CapturePatch;
+      p->timeUs = at;
+      p->frames = 0;
+      p->mask = (1u << count) - 1;
+      memcpy(p->data, channel, count * sizeof(channel[0]));
+      ring.commit();
+      needPatch = false;
+    }
+
+    CaptureRecord* r = ring.claim();
+    if (r == NULL) {
+      needKey = true;  // The host lost a delta, resync with a full record
+      return;
+    }
+    bool key = needKey || ++sinceKey >= CAPTURE_KEY_PERIOD;
+    uint16_t mask = 0;
+    uint8_t n = 0;
+    for (uint8_t k = 0; k < count; k++) {
+      uint8_t v = bufferDmx[channel[k]];
+      if (key || v != last[k]) {
+        mask |= 1u << k;
+        r->data[n++] = v;
+        last[k] = v;
+      }
+    }
+    r->type = TelemetryCapture;
+    r->flags = key ? CaptureKey : 0;
+    r->timeUs = at;
+    r->frames = frames > 0xFFFF ? 0xFFFF : frames;
+    r->mask = mask;
+    ring.commit();
+    lastCount = frameCount;  // Only once a record carries the frames
+    if (key) {
+      needKey = false;
+      sinceKey = 0;
+    }
+  }
+};
+
+DmxCapture dmxCapture;
+
+//**********************************************************************************
+// Replay, console records in, frames out, both on core 0
+class DmxReplay {
+public:
+  RecordRing<CaptureRecord, REPLAY_RING_SIZE> ring;
+  bool active;
+  uint16_t channel[CAPTURE_CHANNELS_MAX];
+  uint8_t count;
+  bool based;           // Time base set by the first frame
+  uint32_t firstUs;     // Capture time of the first frame
+  uint32_t startUs;     // Local time it plays at
+  uint32_t lastFrameMs; // millis() of the last frame written, for checkDMX()
+  uint32_t lastRecordMs;
+  uint32_t played;
+  uint32_t late;
+  uint32_t overflow;
+
+public:
+  DmxReplay() {
+    active = false;
+    count = 0;
+    based = false;
+    firstUs = 0;
+    startUs = 0;
+    lastFrameMs = 0;
+    lastRecordMs = 0;
+    played = 0;
+    late = 0;
+    overflow = 0;
+  }
+
+public:
+
+  // A TelemetryCapture record from the console
+  void receive(const uint8_t* rec, uint32_t len) {
+    CaptureRecord r;
+    if (len < CAPTURE_HEADER_SIZE || len > sizeof(r)) return;
+    memcpy(&r, rec, len);
+    if (len != captureRecordSize(r)) return;
+    if (!active) {
+      if (!(r.flags & CapturePatch)) return;  // Can't place values before a patch
+      begin();
+    }
+    lastRecordMs = millis();
+    CaptureRecord* q = ring.claim();
+    if (q == NULL) {
+      overflow++;
+      return;
+    }
+    uint16_t seq = q->seq;
+    *q = r;
+    q->seq = seq;
+    ring.commit();
+  }
+
+  void begin() {
+    dmxInput.end();  // Live frames would overwrite the replay
+    active = true;
+    based = false;
+    played = 0;
+    late = 0;
+    overflow = 0;
+    Serial.printf("DMX replay started\n");
+  }
+
+  void end() {
+    CaptureRecord r;
+    while (ring.peek(r)) ring.pop();
+    active = false;
+    dmxInput.begin(DMX_PIN, 1, 512);
+    dmxInput.read_async(bufferDmx, dmxFrameArrived);
+    Serial.printf("DMX replay ended: frames:%lu late:%lu overflow:%lu\n", (unsigned long)played, (unsigned long)late, (unsigned long)overflow);
+  }
+
+  // Core 0, once per loop() pass, writes the frames that are due
+  void poll() {
+    if (!active) return;
+    CaptureRecord r;
+    while (ring.peek(r)) {
+      if (r.flags & CaptureEnd) {
+        ring.pop();
+        end();
+        return;
+      }
+      if (r.flags & CapturePatch) {
+        count = __builtin_popcount(r.mask);
+        if (count > CAPTURE_CHANNELS_MAX) count = CAPTURE_CHANNELS_MAX;
+        memcpy(channel, r.data, count * sizeof(channel[0]));
+        ring.pop();
+        continue;
+      }
+      uint32_t now = time_us_32();
+      if (!based) {
+        based = true;
+        firstUs = r.timeUs;
+        startUs = now + REPLAY_LEAD_US;
+      }
+      uint32_t due = startUs + (r.timeUs - firstUs);
+      if ((int32_t)(now - due) < 0) return;
+      if (now - due > REPLAY_LATE_US) late++;
+      uint8_t n = 0;
+      for (uint8_t k = 0; k < count; k++) {
+        if (r.mask & (1u << k)) {
+          uint16_t c = channel[k];
+          if (c < DMXINPUT_BUFFER_SIZE(1, 512)) bufferDmx[c] = r.data[n];
+          n++;
+        }
+      }
+      // Stamped like dmxFrameArrived(), frames the capture missed are counted too
+      dmxFrameUs = now;
+      dmxFrameCount = dmxFrameCount + (r.frames ? r.frames : 1);
+      lastFrameMs = millis();
+      played++;
+      ring.pop();
+    }
+    if (millis() - lastRecordMs > REPLAY_TIMEOUT_MS) end();  // Host went away
+  }
+};
+
+DmxReplay dmxReplay;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+inline void capturePoll() {
+#if RS5_CAPTURE
+  dmxCapture.poll();
+#endif
+}
+
+inline void replayPoll() {
+#if RS5_CAPTURE
+  dmxReplay.poll();
+#endif
+}
+
+void replayReceive(const uint8_t* rec, uint32_t len) {
+#if RS5_CAPTURE
+  dmxReplay.receive(rec, len);
+#endif
+}
+
+void captureToggle() {
+#if RS5_CAPTURE
+  if (dmxCapture.active) dmxCapture.stop();
+  else dmxCapture.start();
+  Serial.printf("DMX capture %s\n", dmxCapture.active ? "on" : "off");
+#else
+  Serial.printf("DMX capture compiled out (RS5_CAPTURE 0)\n");
+#endif
+}
+
+// Arrival of the newest frame in millis(), received or replayed
+unsigned long dmxLastPacketMs() {
+#if RS5_CAPTURE
+  if (dmxReplay.active) return dmxReplay.lastFrameMs;
+#endif
+  return dmxInput.latest_packet_timestamp();
+}
+
+// Drain side, called by Telemetry::nextFrame() after the trace rings
+bool captureNextFrame() {
+#if RS5_CAPTURE
+  CaptureRecord r;
+  if (dmxCapture.ring.peek(r)) {
+    dmxCapture.ring.pop();
+    telemetry.setFrame(&r, captureRecordSize(r));
+    return true;
+  }
+#endif
+  return false;
+}
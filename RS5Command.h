@@ -0,0 +1,361 @@
+// ============================================================================
+// File: RS5Command.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Binary command protocol for live tuning, get and set of the
+//              servo and system settings from the host without a rebuild
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Command Protocol
+//
+// The host sends a CommandRecord in the console's frame format (RS5Telemetry.h
+// FrameReader) and gets the same record back with status and the value now in
+// force, tag echoed so replies can be matched. Every request gets exactly one
+// reply; extras/tools/rs5_command.py waits for it before sending the next.
+//
+// Servo fields belong to core 1: a request goes through a small ring and
+// commandApply() takes it at the top of the next loop1() pass, between two
+// setServoPositions() ticks, so a tick never sees half a change and
+// DL[] picks up new limits at once. System fields and the store operations
+// run on core 0 as the frame arrives. Replies leave through per core rings
+// drained by the telemetry task, TELEMETRY_DRAIN_PERIOD at the latest. A
+// save or recall while servo requests are still queued answers
+// CommandBusy, so it never stores a half applied set.
+//
+// Nothing is allocated: the rings are fixed and a record is 16 bytes.
+#ifndef RS5_COMMAND
+#define RS5_COMMAND 1
+#endif
+
+#define COMMAND_VERSION     1  // Ping reply value
+#define COMMAND_RING_SIZE   8  // Requests queued for core 1, power of two
+#define COMMAND_ACK_SIZE    16 // Replies per core, power of two
+
+enum commandOp {
+  CommandPing = 0,
+  CommandGet = 1,
+  CommandSet = 2,
+  CommandSave = 3,            // Servo tuning and eye presets into the store, console 'S'
+  CommandSavePosition = 4,    // target: position slot, console 'P'
+  CommandRecallPosition = 5   // target: position slot, console 'R'
+};
+
+enum commandStatus {
+  CommandOk = 0,
+  CommandBadOp,
+  CommandBadField,
+  CommandBadTarget,
+  CommandBadValue,
+  CommandReadOnly,
+  CommandBusy,     // Queue full or servo requests pending, send again
+  CommandFailed    // Store operation failed
+};
+
+// Per servo fields, target is the servo
+enum commandServoField {
+  CommandLicensed = 0,   // Read only
+  CommandMinDeg,         // servoMinDeg <= minDeg < maxDeg
+  CommandMaxDeg,         // minDeg < maxDeg <= servoMaxDeg
+  CommandMaxVel,         // deg/s, > 0
+  CommandMaxAcc,         // deg/s^2, > 0
+  CommandMaxDec,         // deg/s^2, > 0
+  CommandSmooth,         // 0 or 1
+  CommandMinPWM,         // us, 0 < minPWM < maxPWM
+  CommandMaxPWM,         // us, below one PWM period
+  CommandSleep,          // ms without a move before the PWM sleeps, >= 0
+  CommandServoMinDeg,    // Read only from here
+  CommandServoMaxDeg,
+  CommandFreq,
+  CommandStartDeg,
+  CommandServoFieldCount
+};
+
+// System fields, target ignored
+enum commandSystemField {
+  CommandDebugLevel = 0x80,  // 0-7, the log mask and telemetry follow
+  CommandDebugServo,         // 0 to NUM_LIC_SERVOS - 1
+  CommandDMXAddress,         // Read only, dip switches
+  CommandRunMode,            // Read only
+  CommandPacketAgeLimit,     // ms before DMX counts as lost, > 0
+  CommandCurrentBudget,      // Governor budget, SERVO_CURRENT_LOW-HIGH scale, > 0
+  CommandCurrent,            // Read only, servo supply current
+  CommandSystemFieldEnd
+};
+
+struct CommandRecord {
+  uint8_t type;      // TelemetryCommand
+  uint8_t op;        // commandOp
+  uint16_t seq;      // Reply ring sequence, gaps show dropped replies
+  uint16_t tag;      // Set by the host, echoed
+  uint8_t target;    // Servo or position slot
+  uint8_t field;     // commandServoField or commandSystemField
+  float value;       // Set: new value, reply: value in force
+  uint8_t status;    // Reply: commandStatus
+  uint8_t reserved[3];
+};
+
+static_assert(sizeof(CommandRecord) == 16, "CommandRecord must stay 16 bytes, the host tools depend on it");
+
+extern Derivs_Limiter DL[];  // SkullMasterV2.ino
+
+#if RS5_COMMAND
+
+//**********************************************************************************
+// Command Channel
+class CommandChannel {
+public:
+  RecordRing<CommandRecord, COMMAND_RING_SIZE> request;  // Core 0 to core 1
+  RecordRing<CommandRecord, COMMAND_ACK_SIZE> ack[2];    // Replies, one per core
+  uint32_t received;
+  uint32_t bad;       // Frames of the wrong size
+
+public:
+  CommandChannel() {
+    received = 0;
+    bad = 0;
+  }
+
+public:
+
+  // Queue the reply on the calling core, dropped and counted if that ring is full
+  void reply(const CommandRecord& c, uint8_t status, float value) {
+    RecordRing<CommandRecord, COMMAND_ACK_SIZE>& q = ack[get_core_num() & 1];
+    CommandRecord* r = q.claim();
+    if (r == NULL) return;
+    uint16_t seq = r->seq;
+    *r = c;
+    r->seq = seq;
+    r->status = status;
+    r->value = value;
+    q.commit();
+  }
+
+  // Core 1, servo fields
+  uint8_t getServo(uint8_t i, uint8_t field, float& value) {
+    ServoConfig& c = C1_config_R[i];
+    switch (field) {
+      case CommandLicensed: value = c.licensed; break;
+      case CommandMinDeg: value = c.minDeg; break;
+      case CommandMaxDeg: value = c.maxDeg; break;
+      case CommandMaxVel: value = c.maxVel; break;
+      case CommandMaxAcc: value = c.maxAcc; break;
+      case CommandMaxDec: value = c.maxDec; break;
+      case CommandSmooth: value = c.smooth; break;
+      case CommandMinPWM: value = c.minPWM; break;
+      case CommandMaxPWM: value = c.maxPWM; break;
+      case CommandSleep: value = c.servoSleepTimer; break;
+      case CommandServoMinDeg: value = c.servoMinDeg; break;
+      case CommandServoMaxDeg: value = c.servoMaxDeg; break;
+      case CommandFreq: value = c.freq; break;
+      case CommandStartDeg: value = c.ServoStartDeg; break;
+      default: return CommandBadField;
+    }
+    return CommandOk;
+  }
+
+  uint8_t setServo(uint8_t i, uint8_t field, float v) {
+    ServoConfig& c = C1_config_R[i];
+    if (field >= CommandServoFieldCount) return CommandBadField;
+    if (field == CommandLicensed || field >= CommandServoMinDeg) return CommandReadOnly;
+    if (!c.licensed) return CommandBadTarget;
+    if (isnan(v)) return CommandBadValue;
+    switch (field) {
+      case CommandMinDeg:
+        if (v < c.servoMinDeg || v >= c.maxDeg) return CommandBadValue;
+        c.minDeg = v;
+        break;
+      case CommandMaxDeg:
+        if (v > c.servoMaxDeg || v <= c.minDeg) return CommandBadValue;
+        c.maxDeg = v;
+        break;
+      case CommandMaxVel:
+        if (v <= 0) return CommandBadValue;
+        c.maxVel = v;
+        DL[i].setVelLimit(v);
+        break;
+      case CommandMaxAcc:
+        if (v <= 0) return CommandBadValue;
+        c.maxAcc = v;
+        break;
+      case CommandMaxDec:
+        if (v <= 0) return CommandBadValue;
+        c.maxDec = v;
+        break;
+      case CommandSmooth:
+        if (v != 0 && v != 1) return CommandBadValue;
+        c.smooth = v;
+        break;
+      case CommandMinPWM:
+        if (v <= 0 || v >= c.maxPWM) return CommandBadValue;
+        c.minPWM = v;
+        break;
+      case CommandMaxPWM:
+        if (v <= c.minPWM || v >= 1000000.0f / c.freq) return CommandBadValue;
+        c.maxPWM = v;
+        break;
+      case CommandSleep:
+        if (v < 0) return CommandBadValue;
+        c.servoSleepTimer = v;
+        C1_run_R[i].servoSleepTimer = c.servoSleepTimer;
+        break;
+    }
+    // Same limits setup1() builds, acceleration unlimited without smoothing
+    if (field == CommandMaxAcc || field == CommandMaxDec || field == CommandSmooth) {
+      DL[i].setAccelLimit(c.smooth ? c.maxAcc : INFINITY);
+      DL[i].setDecelLimit(c.smooth ? c.maxDec : INFINITY);
+    }
+    // A held target outside the new travel moves inside it
+    if (field == CommandMinDeg || field == CommandMaxDeg) {
+      float target = C1_run_R[i].gettargetPos();
+      if (target < c.minDeg || target > c.maxDeg) C1_run_R[i].settargetPos(constrain(target, c.minDeg, c.maxDeg));
+    }
+    return CommandOk;
+  }
+
+  // Core 0, system fields
+  uint8_t getSystem(uint8_t field, float& value) {
+    switch (field) {
+      case CommandDebugLevel: value = systemState.getDebugLevel(); break;
+      case CommandDebugServo: value = systemState.getDebugServo(); break;
+      case CommandDMXAddress: value = systemState.getDMXAddress(); break;
+      case CommandRunMode: value = systemState.getMode(); break;
+      case CommandPacketAgeLimit: value = systemState.getDMXPacketAgeLimit(); break;
+      case CommandCurrentBudget: value = governorBudget(); break;
+      case CommandCurrent: value = currentNow(); break;
+      default: return CommandBadField;
+    }
+    return CommandOk;
+  }
+
+  uint8_t setSystem(uint8_t field, float v) {
+    if (field < CommandDebugLevel || field >= CommandSystemFieldEnd) return CommandBadField;
+    if (field == CommandDMXAddress || field == CommandRunMode || field == CommandCurrent) return CommandReadOnly;
+    if (isnan(v) || v != (int)v) return CommandBadValue;
+    switch (field) {
+      case CommandDebugLevel:
+        if (v < DebugLevelNone || v > DebugLevelServoFull) return CommandBadValue;
+        systemState.setDebugLevel(v);
+        logSetDebugLevel(v);
+        telemetryFollowLog();
+        break;
+      case CommandDebugServo:
+        if (v < 0 || v >= NUM_LIC_SERVOS) return CommandBadValue;
+        systemState.setDebugServo(v);
+        break;
+      case CommandPacketAgeLimit:
+        if (v <= 0) return CommandBadValue;
+        systemState.setDMXPacketAgeLimit(v);
+        break;
+      case CommandCurrentBudget:
+        if (v <= 0) return CommandBadValue;
+        if (!governorSetBudget(v)) return CommandReadOnly;  // Governor compiled out
+        break;
+    }
+    return CommandOk;
+  }
+
+  // Core 0, a decoded frame from readConsole()
+  void receive(const uint8_t* rec, uint32_t len) {
+    if (len != sizeof(CommandRecord)) {
+      bad++;
+      return;
+    }
+    CommandRecord c;
+    memcpy(&c, rec, sizeof(c));
+    received++;
+    telemetry.enable(TelemetryCommand, true);  // Replies need the drain task running
+    float value = c.value;
+    uint8_t status = CommandOk;
+    bool pending = request.head != request.tail;
+    switch (c.op) {
+      case CommandPing:
+        value = COMMAND_VERSION;
+        break;
+      case CommandGet:
+      case CommandSet:
+        if (c.field >= CommandDebugLevel) {
+          status = c.op == CommandGet ? getSystem(c.field, value) : setSystem(c.field, c.value);
+          if (c.op == CommandSet) getSystem(c.field, value);
+          break;
+        }
+        if (c.target >= NUM_SERVO_PINS) {
+          status = CommandBadTarget;
+          break;
+        }
+        if (CommandRecord* r = request.claim()) {
+          *r = c;  // seq is the request ring's, the reply takes its own
+          request.commit();
+          return;  // Core 1 replies
+        }
+        status = CommandBusy;
+        break;
+      case CommandSave:
+        if (pending) status = CommandBusy;
+        else if (!storeSaveConfig()) status = CommandFailed;
+        break;
+      case CommandSavePosition:
+      case CommandRecallPosition:
+        if (c.target >= STORE_POSITIONS) status = CommandBadTarget;
+        else if (pending) status = CommandBusy;
+        else if (!(c.op == CommandSavePosition ? storeSavePosition(c.target) : storeRecallPosition(c.target))) status = CommandFailed;
+        break;
+      default:
+        status = CommandBadOp;
+        break;
+    }
+    reply(c, status, value);
+  }
+
+  // Core 1, between two control ticks
+  void apply() {
+    CommandRecord c;
+    while (request.peek(c)) {
+      request.pop();
+      float value = c.value;
+      uint8_t status = c.op == CommandSet ? setServo(c.target, c.field, c.value) : getServo(c.target, c.field, value);
+      if (c.op == CommandSet) getServo(c.target, c.field, value);  // Value in force, a refused set included
+      reply(c, status, value);
+    }
+  }
+};
+
+CommandChannel commandChannel;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+
+// consoleRecord(), a TelemetryCommand frame
+void commandReceive(const uint8_t* rec, uint32_t len) {
+#if RS5_COMMAND
+  commandChannel.receive(rec, len);
+#endif
+}
+
+// Core 1 loop1(), before setServoPositions()
+inline void commandApply() {
+#if RS5_COMMAND
+  if (commandChannel.request.head == commandChannel.request.tail) return;
+  commandChannel.apply();
+#endif
+}
+
+// Drain side, called by Telemetry::nextFrame() after DMX capture
+bool commandNextFrame() {
+#if RS5_COMMAND
+  CommandRecord r;
+  for (int c = 0; c < 2; c++) {
+    if (commandChannel.ack[c].peek(r)) {
+      commandChannel.ack[c].pop();
+      telemetry.setFrame(&r, sizeof(r));
+      return true;
+    }
+  }
+#endif
+  return false;
+}
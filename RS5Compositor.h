@@ -0,0 +1,98 @@
+// ============================================================================
+// File: RS5Compositor.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Eye compositor, integer crossfades between eye presets and RGB
+//              mode so the eye pixel is written once per frame
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#define EYE_EFFECT_NONE      -1
+#define EYE_EFFECT_RGB       EYE_LUT_RGB  // RGB mode, setEyeColor()
+#define EYE_EFFECT_SNAPSHOT  0x100        // Frozen output, used when a fade is interrupted
+
+//**********************************************************************************
+// Output of one eye effect for one frame
+struct EyeOutput {
+  uint8_t rgb[3];
+  uint8_t level;  // Pixel level, see PixelFrame::setLevel()
+};
+
+//**********************************************************************************
+// Eye Compositor
+//
+// Tracks which effect is showing and, for fadeTime ms after a change, which
+// effect is fading out. Both are rendered live during the fade and mixed with
+// a Q8 weight, so a flickering preset keeps flickering while it fades. If a new
+// effect is selected mid fade, the last mixed output is frozen and used as the
+// outgoing side so the eye never jumps.
+class EyeCompositor {
+public:
+  int current;          // Effect fading in (or showing)
+  int previous;         // Effect fading out, EYE_EFFECT_NONE when not fading
+  uint32_t fadeStart;   // ms
+  uint16_t fadeTime;    // ms, 0 = hard cut
+  EyeOutput snapshot;   // Frozen outgoing output
+  EyeOutput last;       // Last output written to the eye pixel
+
+public:
+  EyeCompositor(uint16_t t = EYE_FADE_TIME) {
+    current = EYE_EFFECT_NONE;
+    previous = EYE_EFFECT_NONE;
+    fadeStart = 0;
+    fadeTime = t;
+    snapshot = { { 0, 0, 0 }, 0 };
+    last = { { 0, 0, 0 }, 0 };
+  }
+
+public:
+
+  // Select the effect that should be showing, starts a fade if it changed
+  bool select(int effect, uint32_t now) {
+    if (effect == current) return false;
+    if (current == EYE_EFFECT_NONE || fadeTime == 0) {
+      previous = EYE_EFFECT_NONE;  // First effect after boot or fades disabled
+    } else if (previous != EYE_EFFECT_NONE) {
+      snapshot = last;  // Interrupted fade, fade out from what is on the eye now
+      previous = EYE_EFFECT_SNAPSHOT;
+    } else {
+      previous = current;
+    }
+    current = effect;
+    fadeStart = now;
+    return true;
+  }
+
+  // Weight of the incoming effect, 0-256. Ends the fade when it reaches 256.
+  uint16_t mix(uint32_t now) {
+    if (previous == EYE_EFFECT_NONE) return 256;
+    uint32_t elapsed = now - fadeStart;
+    if (elapsed >= fadeTime) {
+      previous = EYE_EFFECT_NONE;
+      return 256;
+    }
+    return (elapsed << 8) / fadeTime;
+  }
+
+  bool fading() {
+    return previous != EYE_EFFECT_NONE;
+  }
+
+  // out = from * (256 - a) + to * a, all Q8. The pixel shows colour times
+  // level, so both sides are premultiplied by their level and mixed at level
+  // 255; mixing colour and level apart would light up a fade between two dark
+  // outputs (red at level 0 to black at full level peaks at a quarter red).
+  static void blend(const EyeOutput& from, const EyeOutput& to, uint16_t a, EyeOutput& out) {
+    uint16_t b = 256 - a;
+    for (int c = 0; c < 3; c++) {
+      uint32_t f = from.rgb[c] * from.level / 255;
+      uint32_t t = to.rgb[c] * to.level / 255;
+      out.rgb[c] = (f * b + t * a) >> 8;
+    }
+    out.level = 255;
+  }
+};
+
+EyeCompositor eyeCompositor;
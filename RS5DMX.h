@@ -50,7 +50,7 @@ public:
   System() {
     boot = 0;   // 0 = Core0 Setup, 1 = Core 1 Setup, 2 = Core 0 start, 3 = Core 0 Start, 5 = Run.
     mode = 0;   // 0 = DMX, 1 = Serial, 2 = Program, 3 = XXX, 4 = Demo Mode
-    debug = 0;  // 0 = none, 1 = boot info Only, 2 = DebugLevelDMX 1, 3 = Debug servo 2, 4 = Model 5, 5= voltage and current, 6 Eye Pixel Debug
+    debug = 0;  // 0 = none, 1 = boot info Only, 2 = DebugLevelDMX 1, 3 = Debug servo 2, 4 = Model 5, 5= voltage and current, 6 Eye Pixel Debug, 7 Servo Full
     debugServo = 0;
     servoDebugSampleRate = 200;
     servoDebugLastSample = 0;
@@ -282,8 +282,8 @@ enum debugLevel {
   DebugLevelServo = 3,
   DebugLevelModel = 4,
   DebugLevelVoltCurrent = 5,
-  DebugLevelServoFull = 5,
-  DebugLevelPixel = 6
+  DebugLevelPixel = 6,
+  DebugLevelServoFull = 7
 
 };
 
@@ -307,7 +307,7 @@ public:
 
 };
 
-StatusLight statusLight[14] = {
+StatusLight statusLight[16] = {
   // r,g,b,rate         (Milliseconds)
 
   // Boot Color Codes
@@ -328,7 +328,9 @@ StatusLight statusLight[14] = {
   { 1, 1, 0, 100, 0 },  // 10 - Servo Movement
   { 0, 1, 0, 100, 0 },  // 11 - Servo Still
   { 1, 0, 0, 100, 0 },  // 12 = Servo PWM Disabled
-  { 0, 0, 0, 100, 0 }   // 13 - Status Light Off
+  { 0, 0, 0, 100, 0 },  // 13 - Status Light Off
+  { 0, 1, 1, 300, 0 },  // 14 - Program Playback
+  { 0, 0, 1, 100, 0 }   // 15 - Servo Stalled, resting
 };
 
 #define STATUS_BOOT 0
@@ -348,6 +350,8 @@ StatusLight statusLight[14] = {
 #define SERVO_STATUS_PWM_DISABLED 12
 
 #define STATUS_OFF 13
+#define STATUS_PROGRAM 14
+#define SERVO_STATUS_STALLED 15
 
 
 
@@ -746,6 +750,19 @@ public:
     run_Data_unlock();
   }
 
+  // Sub-degree position and target, the Pos accessors above and below are whole degrees
+  void setcurentDeg(float f) {
+    run_Data_lock();
+    curentPos = f;
+    run_Data_unlock();
+  }
+
+  void settargetDeg(float f) {
+    run_Data_lock();
+    targetPos = f;
+    run_Data_unlock();
+  }
+
   void setpreviousPos(int i) {
     run_Data_lock();
     previousPos = i;
@@ -774,6 +791,14 @@ public:
     return targetPos;
   }
 
+  float getcurentDeg() {
+    return curentPos;
+  }
+
+  float gettargetDeg() {
+    return targetPos;
+  }
+
   int getpreviousPos() {
     return previousPos;
   }
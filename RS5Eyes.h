@@ -0,0 +1,164 @@
+// ============================================================================
+// File: RS5Eyes.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Eye preset table compiled at boot from eyeLight[] and user
+//              presets in flash, with a 256 entry DMX value to preset lookup
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#define MAX_EYE_PRESETS   32
+#define EYE_LUT_HOLD      0xFF  // DMX value not assigned to a preset, keep the current one
+#define EYE_LUT_RGB       0xFE  // DMX value selects RGB mode (setEyeColor)
+#define EYE_RGB_MODE_MAX  9     // DMX values 0-9 on the preset channel select RGB mode
+
+#define EYE_PRESET_MAGIC    0x45355352  // "RS5E"
+#define EYE_PRESET_VERSION  1
+
+//**********************************************************************************
+// Compiled Eye Preset, everything flickerEyes() needs already unpacked
+class EyePreset {
+public:
+  uint8_t color[3][3];      // base, flicker, black as r,g,b
+  uint16_t weight[3];       // cumulative pick weights, base / base+flicker / total
+  uint8_t stop[3];          // position of each colour on the 0-255 flicker gradient
+  uint16_t flickerDelay;    // ms
+  uint16_t flickerRange;
+  uint8_t brightness;
+  uint8_t dmxStart;
+  uint8_t dmxEnd;
+};
+
+#define EYE_COLOR_BASE    0
+#define EYE_COLOR_FLICKER 1
+#define EYE_COLOR_BLACK   2
+
+//**********************************************************************************
+// User Eye Presets in flash
+//
+// Records laid out like NeoPixelEyes (11 x int32, baseColor through dmxEnd),
+// kept in the config store (RS5Store.h). The legacy blob at
+// FLASH_EYE_PRESET_OFFSET is a header followed by count records. User presets
+// are compiled after the built in table, so their DMX ranges win where they
+// overlap.
+struct EyePresetBlobHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  uint32_t crc;  // CRC-32 of the records
+};
+
+struct EyePresetRecord {
+  int32_t baseColor;
+  int32_t flickerColor;
+  int32_t blackColor;
+  int32_t flickerDelay;
+  int32_t flickerRange;
+  int32_t brightness;
+  int32_t baseColorTime;
+  int32_t flickerColorTime;
+  int32_t blackColorTime;
+  int32_t dmxStart;
+  int32_t dmxEnd;
+};
+
+//**********************************************************************************
+// Eye Preset Table
+class EyePresetTable {
+public:
+  uint8_t dmxToPreset[256];           // DMX value -> preset index, EYE_LUT_HOLD or EYE_LUT_RGB
+  EyePreset preset[MAX_EYE_PRESETS];  // Compiled presets, built in first
+  int count;                          // Presets compiled
+  int userCount;                      // Of which came from flash
+
+public:
+  EyePresetTable() {
+    for (int v = 0; v < 256; v++) dmxToPreset[v] = EYE_LUT_HOLD;
+    count = 0;
+    userCount = 0;
+  }
+
+public:
+
+  // Compile one preset and claim its DMX range in the lookup table
+  bool add(int baseColor, int flickerColor, int blackColor, int flickerDelay, int flickerRange, int brightness,
+           int baseColorTime, int flickerColorTime, int blackColorTime, int dmxStart, int dmxEnd) {
+    if (count >= MAX_EYE_PRESETS) return false;
+
+    EyePreset& p = preset[count];
+    int colors[3] = { baseColor, flickerColor, blackColor };
+    for (int c = 0; c < 3; c++) {
+      p.color[c][0] = (colors[c] >> 16) & 0xFF;
+      p.color[c][1] = (colors[c] >> 8) & 0xFF;
+      p.color[c][2] = colors[c] & 0xFF;
+    }
+    p.weight[EYE_COLOR_BASE] = constrain(baseColorTime, 0, 1000);
+    p.weight[EYE_COLOR_FLICKER] = p.weight[EYE_COLOR_BASE] + constrain(flickerColorTime, 0, 1000);
+    p.weight[EYE_COLOR_BLACK] = p.weight[EYE_COLOR_FLICKER] + constrain(blackColorTime, 0, 1000);
+    if (p.weight[EYE_COLOR_BLACK] == 0) p.weight[EYE_COLOR_BASE] = p.weight[EYE_COLOR_FLICKER] = p.weight[EYE_COLOR_BLACK] = 1;  // all zero, always base
+
+    // Flicker gradient runs black -> flicker -> base, each colour gets a share
+    // of 0-255 in proportion to its weight and sits in the middle of its share
+    uint32_t total = p.weight[EYE_COLOR_BLACK];
+    uint32_t e1 = (uint32_t)(p.weight[EYE_COLOR_BLACK] - p.weight[EYE_COLOR_FLICKER]) * 255 / total;
+    uint32_t e2 = (uint32_t)(p.weight[EYE_COLOR_BLACK] - p.weight[EYE_COLOR_BASE]) * 255 / total;
+    p.stop[EYE_COLOR_BLACK] = e1 / 2;
+    p.stop[EYE_COLOR_FLICKER] = (e1 + e2) / 2;
+    p.stop[EYE_COLOR_BASE] = (e2 + 255) / 2;
+
+    p.flickerDelay = constrain(flickerDelay, 1, 60000);
+    p.flickerRange = constrain(flickerRange, 0, 60000);
+    p.brightness = constrain(brightness, 0, 255);
+    p.dmxStart = constrain(dmxStart, 0, 255);
+    p.dmxEnd = constrain(dmxEnd, 0, 255);
+
+    for (int v = p.dmxStart; v <= p.dmxEnd; v++) {
+      if (v > EYE_RGB_MODE_MAX) dmxToPreset[v] = count;
+    }
+    count++;
+    return true;
+  }
+
+  // Build the table from the compiled in presets
+  void compile(NeoPixelEyes* src, int n) {
+    count = 0;
+    userCount = 0;
+    for (int v = 0; v < 256; v++) dmxToPreset[v] = (v <= EYE_RGB_MODE_MAX) ? EYE_LUT_RGB : EYE_LUT_HOLD;
+    for (int i = 0; i < n; i++) {
+      add(src[i].baseColor, src[i].flickerColor, src[i].blackColor, src[i].flickerDelay, src[i].flickerRange, src[i].brightness,
+          src[i].baseColorTime, src[i].flickerColorTime, src[i].blackColorTime, src[i].dmxStart, src[i].dmxEnd);
+    }
+  }
+
+  // Append n user presets. Returns number loaded.
+  int addUser(const EyePresetRecord* r, int n) {
+    int loaded = 0;
+    for (int i = 0; i < n; i++) {
+      if (!add(r[i].baseColor, r[i].flickerColor, r[i].blackColor, r[i].flickerDelay, r[i].flickerRange, r[i].brightness,
+               r[i].baseColorTime, r[i].flickerColorTime, r[i].blackColorTime, r[i].dmxStart, r[i].dmxEnd)) break;
+      loaded++;
+    }
+    userCount += loaded;
+    return loaded;
+  }
+
+  uint8_t lookup(uint8_t dmx) {
+    return dmxToPreset[dmx];
+  }
+
+};
+
+EyePresetTable eyePresets;
+
+int storeEyePresets(const EyePresetRecord*& records);  // RS5Store.h
+
+//**********************************************************************************
+// Compile the eye preset table, built in presets first then user presets from flash
+void compileEyePresets() {
+  eyePresets.compile(eyeLight, sizeof(eyeLight) / sizeof(eyeLight[0]));
+  const EyePresetRecord* user;
+  int n = storeEyePresets(user);
+  eyePresets.addUser(user, n);
+}
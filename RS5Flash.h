@@ -0,0 +1,92 @@
+// ============================================================================
+// File: RS5Flash.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Flash map for data stored beside the firmware, XIP read and
+//              write helpers and CRC used to validate stored blobs
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <hardware/flash.h>
+
+//**********************************************************************************
+// Flash Map
+//
+// Data regions live inside the filesystem area the arduino-pico linker script
+// reserves at the top of flash (Tools > Flash Size, pick an option with at
+// least 64KB of FS). The firmware never mounts a filesystem there. Offsets
+// below are relative to the start of that area and must be sector aligned.
+extern uint8_t _FS_start[];  // Unsized, so copies out of a region aren't bounded to one byte
+extern uint8_t _FS_end[];
+
+#define FLASH_EYE_PRESET_OFFSET   0                    // User eye presets, one sector
+#define FLASH_EYE_PRESET_SIZE     FLASH_SECTOR_SIZE
+
+#define FLASH_PROGRAM_OFFSET      (FLASH_EYE_PRESET_OFFSET + FLASH_EYE_PRESET_SIZE)  // Choreography, RS5Program.h
+#define FLASH_PROGRAM_SIZE        (12 * FLASH_SECTOR_SIZE)
+
+#define FLASH_STORE_OFFSET        (FLASH_PROGRAM_OFFSET + FLASH_PROGRAM_SIZE)  // Config store, RS5Store.h
+#define FLASH_STORE_SIZE          (2 * FLASH_SECTOR_SIZE)
+
+#define FLASH_REGION_END          (FLASH_STORE_OFFSET + FLASH_STORE_SIZE)
+
+// Is the region inside the area reserved by the linker
+bool flashRegionAvailable(uint32_t offset, uint32_t size) {
+  return (uint32_t)(_FS_end - _FS_start) >= offset + size;
+}
+
+// Memory mapped (XIP) address of a region, read in place without copying
+const uint8_t* flashRegionAddr(uint32_t offset) {
+  return _FS_start + offset;
+}
+
+// Every byte erased, read in place. Core 0, about a millisecond for the program region
+bool flashRegionBlank(uint32_t offset, uint32_t size) {
+  const uint32_t* p = (const uint32_t*)flashRegionAddr(offset);
+  for (uint32_t i = 0; i < size / 4; i++) {
+    if (p[i] != 0xFFFFFFFF) return false;
+  }
+  return true;
+}
+
+// Offset from the start of flash, as used by flash_range_erase/program
+uint32_t flashRegionOffset(uint32_t offset) {
+  return (uint32_t)(_FS_start - (uint8_t*)XIP_BASE) + offset;
+}
+
+//**********************************************************************************
+// Erase and program, core 0 only. The code runs from XIP, so for as long as
+// the flash is busy the other core is parked in RAM and interrupts are off.
+// Keep each call short: a sector erase takes about 45ms, a page about 0.5ms.
+void flashRegionErase(uint32_t offset, uint32_t size) {
+  noInterrupts();
+  rp2040.idleOtherCore();
+  flash_range_erase(flashRegionOffset(offset), size);
+  rp2040.resumeOtherCore();
+  interrupts();
+}
+
+void flashRegionProgram(uint32_t offset, const uint8_t* data, uint32_t size) {
+  noInterrupts();
+  rp2040.idleOtherCore();
+  flash_range_program(flashRegionOffset(offset), data, size);
+  rp2040.resumeOtherCore();
+  interrupts();
+}
+
+//**********************************************************************************
+// CRC-32 (IEEE 802.3, reflected), bitwise so it needs no table in RAM
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+uint32_t crc32(const uint8_t* data, uint32_t len) {
+  return crc32Update(0, data, len);
+}
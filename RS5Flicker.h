@@ -0,0 +1,130 @@
+// ============================================================================
+// File: RS5Flicker.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Fixed point procedural fire/flicker generator using a xorshift
+//              PRNG and 1D value noise, driven by the compiled eye presets
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Fast Random, xorshift32. Deterministic for a given seed and a handful of
+// shifts per number, far cheaper than Arduino random().
+class FastRandom {
+public:
+  uint32_t state;
+
+public:
+  FastRandom(uint32_t seed = 0x2545F491) {
+    state = seed ? seed : 1;  // xorshift never leaves zero
+  }
+
+public:
+
+  uint32_t next() {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+  }
+
+  // Uniform in 0..n-1 for n up to 65535, no division
+  uint32_t below(uint32_t n) {
+    return ((next() >> 16) * n) >> 16;
+  }
+};
+
+// Hash a lattice index to 0-255. One multiply and a xorshift round, so any
+// lattice point can be evaluated directly without stepping a sequence.
+uint8_t noiseLattice(uint32_t seed, uint32_t i) {
+  uint32_t x = (i * 0x9E3779B1) ^ seed;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  x *= 0x2C1B3C6D;
+  return x >> 24;
+}
+
+// 1D value noise, 0-255. Lattice points every period ms, smoothstep between.
+uint8_t valueNoise(uint32_t seed, uint32_t t, uint32_t period) {
+  if (period == 0) period = 1;
+  uint32_t i = t / period;
+  uint32_t f = ((t - i * period) << 16) / period;        // Q16 fraction, period is at most 60000
+  uint32_t ff = (f * f) >> 16;                            // f^2, Q16
+  uint32_t s = ((ff >> 8) * ((3 * 65536 - 2 * f) >> 8));  // f^2 (3 - 2f), Q16
+  int32_t a = noiseLattice(seed, i);
+  int32_t b = noiseLattice(seed, i + 1);
+  return a + (((b - a) * (int32_t)(s >> 8)) >> 8);
+}
+
+//**********************************************************************************
+// Flicker Engine
+//
+// Per preset parameters come from NeoPixelEyes through the compiled EyePreset:
+//   flickerDelay  - noise period in ms, smaller is a faster flame
+//   flickerRange  - intensity depth in percent, 0 is steady, 100 reaches black
+//   brightness    - peak level of the preset
+//   colour times  - share of the noise range given to black, flicker and base
+// The noise value picks a point on a black -> flicker -> base gradient and sets
+// the intensity, so brighter moments are also closer to the base colour.
+class FlickerEngine {
+public:
+  uint32_t seed;
+  uint8_t noise;      // Last noise value, for debug
+  uint8_t intensity;  // Last intensity, for debug
+
+public:
+  FlickerEngine(uint32_t s = 0x5EED) {
+    seed = s;
+    noise = 0;
+    intensity = 0;
+  }
+
+public:
+
+  // Render preset p at time now (ms), returns the colour as r,g,b
+  void render(const EyePreset& p, uint32_t now, uint8_t out[3]) {
+    // Two octaves, the second three times faster at half the weight
+    uint32_t slow = valueNoise(seed, now, p.flickerDelay);
+    uint32_t fast = valueNoise(seed ^ 0xA5A5A5A5, now, p.flickerDelay / 3 + 1);
+    uint32_t n = (slow * 2 + fast) / 3;
+    noise = n;
+
+    // Gradient between the colour stops
+    const uint8_t* lo;
+    const uint8_t* hi;
+    uint32_t mix;
+    if (n <= p.stop[EYE_COLOR_BLACK]) {
+      lo = hi = p.color[EYE_COLOR_BLACK];
+      mix = 0;
+    } else if (n < p.stop[EYE_COLOR_FLICKER]) {
+      lo = p.color[EYE_COLOR_BLACK];
+      hi = p.color[EYE_COLOR_FLICKER];
+      mix = ((n - p.stop[EYE_COLOR_BLACK]) << 8) / (p.stop[EYE_COLOR_FLICKER] - p.stop[EYE_COLOR_BLACK]);
+    } else if (n < p.stop[EYE_COLOR_BASE]) {
+      lo = p.color[EYE_COLOR_FLICKER];
+      hi = p.color[EYE_COLOR_BASE];
+      mix = ((n - p.stop[EYE_COLOR_FLICKER]) << 8) / (p.stop[EYE_COLOR_BASE] - p.stop[EYE_COLOR_FLICKER]);
+    } else {
+      lo = hi = p.color[EYE_COLOR_BASE];
+      mix = 0;
+    }
+
+    // Intensity dips with the noise by flickerRange percent, then the preset level
+    uint32_t depth = p.flickerRange >= 100 ? 256 : (p.flickerRange * 256) / 100;
+    uint32_t level = 256 - ((depth * (255 - n)) >> 8);
+    level = (level * (p.brightness + 1)) >> 8;
+    intensity = level > 255 ? 255 : level;
+
+    for (int c = 0; c < 3; c++) {
+      uint32_t v = lo[c] + ((((int32_t)hi[c] - lo[c]) * (int32_t)mix) >> 8);
+      out[c] = (v * level) >> 8;
+    }
+  }
+};
+
+FlickerEngine eyeFlicker;
@@ -0,0 +1,250 @@
+// ============================================================================
+// File: RS5Governor.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Servo supply current sampled by DMA, and a motion governor
+//              that scales the DL[] limits to keep the current under budget
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+
+//**********************************************************************************
+// Current Sense
+//
+// The ADC converts the current sense input free running at CURRENT_SAMPLE_HZ
+// and a DMA channel writes every conversion into a ring that wraps in
+// hardware, so sampling costs no CPU at all. The mean over the whole ring is
+// the filtered current: CURRENT_RING samples, about 51ms, which covers two
+// servo pulse frames and smooths out the 50Hz ripple. The ring position is
+// never needed, so readers on either core just sum it.
+//
+// The ADC belongs to the sampler from currentStart() on; analogRead() would
+// stop it, so everything reads currentNow() instead.
+//
+// Motion Governor
+//
+// Every GOVERNOR_PERIOD_US core 1 compares the current with the budget. Above
+// GOVERNOR_KNEE percent of it the governor scale drops in proportion, down to
+// GOVERNOR_MIN_SCALE at the budget itself. Each axis takes its *_SERVO_YIELD
+// percent of the cut on its velocity and acceleration limits: the jaw yields
+// nothing and keeps its full speed, background axes slow down. Deceleration
+// limits stay, so an axis that is moving too fast for its new limit brakes
+// at its normal rate. The scale drops at once and recovers by
+// GOVERNOR_RELEASE per period, so the limits don't pump.
+#ifndef RS5_GOVERNOR
+#define RS5_GOVERNOR 1
+#endif
+
+#define CURRENT_SENSE_PIN     29       // ADC3
+#define CURRENT_SAMPLE_HZ     10000
+#define CURRENT_RING          512      // Samples, power of two, the DMA ring wraps on its size in bytes
+#define CURRENT_DMA_COUNT     0xFFFFFFFF  // Transfers before the channel needs arming again, days at 10kHz
+
+#define GOVERNOR_PERIOD_US    5000
+#define GOVERNOR_BUDGET       1500     // SERVO_CURRENT_LOW-HIGH scale, live with the currentbudget command field
+#define GOVERNOR_KNEE         80       // Percent of the budget where limiting starts
+#define GOVERNOR_MIN_SCALE    0.25f    // Limit scale at the budget
+#define GOVERNOR_RELEASE      0.02f    // Scale recovered per period, full recovery in about 190ms
+
+extern Derivs_Limiter DL[];  // SkullMasterV2.ino
+
+#if RS5_GOVERNOR
+
+//**********************************************************************************
+// Current sense, the DMA ring
+class CurrentSense {
+public:
+  uint16_t ring[CURRENT_RING] __attribute__((aligned(CURRENT_RING * sizeof(uint16_t))));
+  int channel;  // DMA channel, -1 before start()
+
+public:
+  CurrentSense() {
+    memset(ring, 0, sizeof(ring));
+    channel = -1;
+  }
+
+public:
+
+  void start() {
+    adc_init();
+    adc_gpio_init(CURRENT_SENSE_PIN);
+    adc_select_input(CURRENT_SENSE_PIN - 26);
+    adc_fifo_setup(true, true, 1, false, false);  // FIFO on, DREQ at one sample, 12 bit samples
+    adc_set_clkdiv(48000000.0f / CURRENT_SAMPLE_HZ - 1);
+
+    channel = dma_claim_unused_channel(true);
+    arm();
+  }
+
+  void arm() {
+    adc_run(false);
+    adc_fifo_drain();
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, __builtin_ctz(sizeof(ring)));  // Write address wraps on the ring
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(channel, &c, ring, &adc_hw->fifo, CURRENT_DMA_COUNT, true);
+    adc_run(true);
+  }
+
+  // Core 1, now and then: a channel that ran out of transfers starts again
+  void check() {
+    if (channel >= 0 && !dma_channel_is_busy(channel)) arm();
+  }
+
+  // Mean over the ring, SERVO_CURRENT_LOW-HIGH scale
+  int read() {
+    uint32_t sum = 0;
+    for (int i = 0; i < CURRENT_RING; i++) sum += ring[i];
+    return map(sum / CURRENT_RING, 0, 4095, SERVO_CURRENT_LOW, SERVO_CURRENT_HIGH);
+  }
+};
+
+CurrentSense currentSense;
+
+//**********************************************************************************
+// Governor, core 1
+class MotionGovernor {
+public:
+  volatile int budget;
+  uint8_t yield[NUM_SERVO_PINS];  // Percent of the cut each axis takes
+  float scale;                    // 1 unlimited, GOVERNOR_MIN_SCALE at the budget
+  uint32_t lastUs;
+  volatile int current;           // Last reading
+  int peak;
+  float minScale;
+  bool limiting;
+  uint32_t episodes;              // Times limiting started
+  uint32_t limitedUs;
+
+public:
+  MotionGovernor() {
+    budget = GOVERNOR_BUDGET;
+    for (int i = 0; i < NUM_SERVO_PINS; i++) yield[i] = 100;
+    yield[JAW_SERVO_POS] = JAW_SERVO_YIELD;
+    yield[YAW_SERVO_POS] = YAW_SERVO_YIELD;
+    yield[PITCH_SERVO_POS] = PITCH_SERVO_YIELD;
+    yield[ROLL_SERVO_POS] = ROLL_SERVO_YIELD;
+    yield[EYE_SERVO_POS] = EYE_SERVO_YIELD;
+    scale = 1;
+    lastUs = 0;
+    current = 0;
+    peak = 0;
+    minScale = 1;
+    limiting = false;
+    episodes = 0;
+    limitedUs = 0;
+  }
+
+public:
+
+  float axisScale(int i, float s) {
+    return 1 - yield[i] * (1 - s) / 100;
+  }
+
+  // dt: time since the last call
+  void apply(uint32_t dt) {
+    current = currentSense.read();
+    if (current > peak) peak = current;
+
+    int knee = budget * GOVERNOR_KNEE / 100;
+    float target = 1;
+    if (current >= budget) target = GOVERNOR_MIN_SCALE;
+    else if (current > knee) target = 1 - (1 - GOVERNOR_MIN_SCALE) * (current - knee) / (budget - knee);
+
+    float was = scale;
+    if (target < scale) scale = target;
+    else scale = min(target, scale + GOVERNOR_RELEASE);
+    if (scale < minScale) minScale = scale;
+
+    if (limiting) limitedUs += dt;
+    if (scale < 1 && !limiting) episodes++;
+    limiting = scale < 1;
+    if (scale == 1 && was == 1) return;
+
+    // Same limits setup1() builds, scaled; deceleration untouched. Rewritten
+    // every period while limiting, a command that set new limits is scaled too
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      ServoConfig& c = C1_config_R[i];
+      if (!c.licensed) continue;
+      float s = axisScale(i, scale);
+      DL[i].setVelLimit(c.maxVel * s);
+      DL[i].setAccelLimit(c.smooth ? c.maxAcc * s : INFINITY);
+    }
+  }
+
+  void print() {
+    Serial.printf("Current: now %d, peak %d, budget %d, scale %.2f, limited %lu times for %lums\n", current, peak, budget, scale,
+                  (unsigned long)episodes, (unsigned long)(limitedUs / 1000));
+    Serial.printf("Current: lowest axis scale");
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) Serial.printf(" %.2f", axisScale(i, minScale));
+    Serial.printf("\n");
+  }
+};
+
+MotionGovernor motionGovernor;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, analogRead() and no governor when compiled out
+
+// setup(), before core 1 starts the servos
+void currentStart() {
+#if RS5_GOVERNOR
+  currentSense.start();
+#endif
+}
+
+// Servo supply current, SERVO_CURRENT_LOW-HIGH scale
+int currentNow() {
+#if RS5_GOVERNOR
+  return currentSense.read();
+#else
+  return map(analogRead(CURRENT_SENSE_PIN), 0, 1023, SERVO_CURRENT_LOW, SERVO_CURRENT_HIGH);
+#endif
+}
+
+// Core 1 loop1(), before setServoPositions()
+inline void governorApply() {
+#if RS5_GOVERNOR
+  uint32_t now = time_us_32();
+  if (now - motionGovernor.lastUs < GOVERNOR_PERIOD_US) return;
+  currentSense.check();
+  motionGovernor.apply(now - motionGovernor.lastUs);
+  motionGovernor.lastUs = now;
+#endif
+}
+
+int governorBudget() {
+#if RS5_GOVERNOR
+  return motionGovernor.budget;
+#else
+  return 0;
+#endif
+}
+
+// False when compiled out
+bool governorSetBudget(int budget) {
+#if RS5_GOVERNOR
+  motionGovernor.budget = budget;
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Console i
+void governorReport() {
+#if RS5_GOVERNOR
+  motionGovernor.print();
+#else
+  Serial.printf("Current: %d, governor compiled out\n", currentNow());
+#endif
+}
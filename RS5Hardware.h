@@ -15,6 +15,7 @@
 #define NUMPIXELS 8       // Number of Pixels on Status String
 #define STATUSPIXEL 0     // Postion of status pixel on string
 #define EYESPIXEL 7       // PIXEL for EYES
+#define EYE_FADE_TIME 250 // Milliseconds to crossfade between eye presets and RGB mode, 0 = hard cut
 
 //**********************************************************************************
 // setup DMX Recieve
@@ -80,6 +81,7 @@
 #define JAW_SERVO_MINDEG  0
 #define JAW_START_POS    1
 #define JAW_START_SLEEP   1000
+#define JAW_SERVO_YIELD   0   // Never slowed by the current governor (RS5Governor.h)
 
 // Yaw Servo Defaults
 #define YAW_SERVO_POS 1
@@ -90,6 +92,7 @@
 #define YAW_SERVO_MINDEG  0
 #define YAW_START_POS     90
 #define YAW_START_SLEEP   1000
+#define YAW_SERVO_YIELD   100   // Percent of the governor cut this axis takes
 
 // Pitch Servo Defaults
 #define PITCH_SERVO_POS 2
@@ -100,6 +103,7 @@
 #define PITCH_SERVO_MINDEG  0
 #define PITCH_START_POS     90
 #define PITCH_START_SLEEP   1000
+#define PITCH_SERVO_YIELD   100
 
 // Roll Servo Defaults
 #define ROLL_SERVO_POS 3
@@ -110,6 +114,7 @@
 #define ROLL_SERVO_MINDEG  0
 #define ROLL_START_POS     90
 #define ROLL_START_SLEEP   1000
+#define ROLL_SERVO_YIELD   100
 
 // Eye Servo Defaults
 #define EYE_SERVO_POS 4
@@ -120,4 +125,5 @@
 #define EYE_SERVO_MINDEG  0
 #define EYE_START_POS     90
 #define EYE_START_SLEEP   1000
+#define EYE_SERVO_YIELD   50
 
@@ -0,0 +1,158 @@
+// ============================================================================
+// File: RS5Latency.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: End to end DMX to servo latency, frame arrival through
+//              readDMX() and the hand off to core one to the PWM write
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// DMX Latency Tracer
+//
+// dmxFrameArrived() runs from the DmxInput completion interrupt and stamps the
+// frame in microseconds. When readDMX() changes a servo target it tags that
+// axis with the arrival and read times. setServoPositions() on core one picks
+// the tag up after the PWM write and records three distributions:
+//   arrival -> readDMX()            one for all axes, core 0 polling delay
+//   readDMX() -> PWM write          per axis, hand off to core 1
+//   arrival -> PWM write            per axis, end to end
+// Only frames that move a target are tagged, an unchanged cue has nothing to
+// deliver. Compiled out with the profiler (RS5_PROFILER 0).
+volatile uint32_t dmxFrameUs = 0;     // Arrival of the newest frame
+volatile uint32_t dmxFrameCount = 0;  // Frames received
+
+#if RS5_PROFILER
+
+class LatencyTag {
+public:
+  volatile uint32_t arrivalUs;
+  volatile uint32_t readUs;
+  volatile uint32_t seq;  // Bumped by core 0 after a tag is written
+  uint32_t seen;          // Last seq recorded, core 1 only
+};
+
+class DmxLatency {
+public:
+  LatencyTag tag[NUM_LIC_SERVOS];
+  ProfileStat toRead;                      // arrival -> readDMX()
+  ProfileStat toPwm[NUM_LIC_SERVOS];       // readDMX() -> PWM write
+  ProfileStat endToEnd[NUM_LIC_SERVOS];    // arrival -> PWM write
+  uint32_t lastFrame;                      // dmxFrameCount already measured by readDMX()
+
+public:
+  DmxLatency() {
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      tag[i].arrivalUs = 0;
+      tag[i].readUs = 0;
+      tag[i].seq = 0;
+      tag[i].seen = 0;
+    }
+    lastFrame = 0;
+  }
+
+public:
+
+  // Core 0, once per readDMX(). Returns false if no new frame arrived.
+  bool frameRead() {
+    uint32_t count = dmxFrameCount;
+    if (count == lastFrame) return false;
+    lastFrame = count;
+    toRead.record(time_us_32() - dmxFrameUs);
+    return true;
+  }
+
+  // Core 0, after readDMX() changed the target of servo i
+  void tagTarget(int i) {
+    LatencyTag& t = tag[i];
+    t.arrivalUs = dmxFrameUs;
+    t.readUs = time_us_32();
+    __sync_synchronize();  // Target and times visible before the new seq
+    t.seq = t.seq + 1;
+  }
+
+  // Core 1, after the PWM write for servo i
+  void pwmWritten(int i) {
+    LatencyTag& t = tag[i];
+    uint32_t seq = t.seq;
+    if (seq == t.seen) return;
+    __sync_synchronize();
+    uint32_t arrival = t.arrivalUs;
+    uint32_t read = t.readUs;
+    __sync_synchronize();
+    if (t.seq != seq) return;  // Retagged while reading, pick it up next tick
+    t.seen = seq;
+    uint32_t now = time_us_32();
+    toPwm[i].record(now - read);
+    endToEnd[i].record(now - arrival);
+  }
+
+  void reset() {
+    toRead.reset();
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      toPwm[i].reset();
+      endToEnd[i].reset();
+    }
+  }
+
+  void dump() {
+    char name[24];
+    Serial.printf("DMX latency (us), frames:%lu, histogram buckets <1,<2,<4,<8...:\n", (unsigned long)dmxFrameCount);
+    toRead.print("arrival->read");
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (!C1_config_R[i].licensed) continue;
+      snprintf(name, sizeof(name), "s%d read->pwm", i);
+      toPwm[i].print(name);
+      snprintf(name, sizeof(name), "s%d arrival->pwm", i);
+      endToEnd[i].print(name);
+    }
+  }
+};
+
+DmxLatency dmxLatency;
+
+#endif
+
+//**********************************************************************************
+// DmxInput completion callback, interrupt context so keep it to two stores
+void dmxFrameArrived(DmxInput* instance) {
+  (void)instance;
+  dmxFrameUs = time_us_32();
+  dmxFrameCount = dmxFrameCount + 1;
+}
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+inline void latencyFrameRead() {
+#if RS5_PROFILER
+  dmxLatency.frameRead();
+#endif
+}
+
+inline void latencyTagTarget(int i) {
+#if RS5_PROFILER
+  dmxLatency.tagTarget(i);
+#endif
+}
+
+inline void latencyPwmWritten(int i) {
+#if RS5_PROFILER
+  dmxLatency.pwmWritten(i);
+#endif
+}
+
+void latencyReset() {
+#if RS5_PROFILER
+  dmxLatency.reset();
+#endif
+}
+
+void latencyDump() {
+#if RS5_PROFILER
+  dmxLatency.dump();
+#else
+  Serial.printf("Latency tracer compiled out (RS5_PROFILER 0)\n");
+#endif
+}
@@ -0,0 +1,110 @@
+// ============================================================================
+// File: RS5Load.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Per core CPU load, loop rate and worst loop period meters
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Load Meter
+//
+// Each run loop calls loadPass() once per pass and sleeps through loadDelay(),
+// which books the sleep as idle time. Every LOAD_WINDOW_US the meter publishes
+// load (time not idle), passes per second and the longest gap between two
+// passes. The arduino-pico FreeRTOS port owns vApplicationIdleHook(), so idle
+// time is measured at the loops' own wait points instead.
+//
+// loop1() polls flat out and never sleeps, so core 1 always reads close to
+// 100%; its headroom shows in the loop rate and the worst period against
+// LOAD_LOOP1_BUDGET_US.
+#define LOAD_WINDOW_US        1000000
+#define LOAD_LOOP1_BUDGET_US  2500     // Worst loop1() period that still counts as 100% on the status pixel
+
+class LoadMeter {
+public:
+  // Current window
+  uint32_t windowStart;
+  uint32_t idleUs;
+  uint32_t passes;
+  uint32_t lastPass;
+  uint32_t worstUs;
+
+  // Last complete window
+  uint16_t loadPermille;
+  uint32_t rateHz;
+  uint32_t worstPeriodUs;
+
+public:
+  LoadMeter() {
+    windowStart = 0;
+    idleUs = 0;
+    passes = 0;
+    lastPass = 0;
+    worstUs = 0;
+    loadPermille = 0;
+    rateHz = 0;
+    worstPeriodUs = 0;
+  }
+
+public:
+
+  void pass() {
+    uint32_t now = time_us_32();
+    if (lastPass != 0 && now - lastPass > worstUs) worstUs = now - lastPass;
+    lastPass = now;
+    passes++;
+
+    uint32_t window = now - windowStart;
+    if (window >= LOAD_WINDOW_US) {
+      if (windowStart != 0) {
+        uint32_t idle = idleUs < window ? idleUs : window;
+        loadPermille = ((uint64_t)(window - idle) * 1000) / window;
+        rateHz = ((uint64_t)passes * 1000000) / window;
+        worstPeriodUs = worstUs;
+      }
+      windowStart = now;
+      idleUs = 0;
+      passes = 0;
+      worstUs = 0;
+    }
+  }
+
+  void idle(uint32_t us) {
+    idleUs += us;
+  }
+
+  void print(int core) {
+    Serial.printf("Core %d: load %u.%u%%, loop %lu Hz, worst period %lu us\n", core, loadPermille / 10, loadPermille % 10, (unsigned long)rateHz, (unsigned long)worstPeriodUs);
+  }
+};
+
+LoadMeter coreLoad[2];  // Indexed by get_core_num()
+bool loadStatusPixel = false;  // Show load on the status pixel instead of the status blink
+
+//**********************************************************************************
+// Hooks for the run loops
+inline void loadPass() {
+  coreLoad[get_core_num() & 1].pass();
+}
+
+void loadDelay(uint32_t ms) {
+  uint32_t start = time_us_32();
+  delay(ms);
+  coreLoad[get_core_num() & 1].idle(time_us_32() - start);
+}
+
+void loadDump() {
+  for (int c = 0; c < 2; c++) coreLoad[c].print(c);
+}
+
+// Saturation of the busier core, 0-1000. Core 0 by load, core 1 by its worst
+// loop period against LOAD_LOOP1_BUDGET_US.
+uint16_t loadSaturation() {
+  uint32_t core0 = coreLoad[0].loadPermille;
+  uint32_t core1 = ((uint64_t)coreLoad[1].worstPeriodUs * 1000) / LOAD_LOOP1_BUDGET_US;
+  uint32_t s = core0 > core1 ? core0 : core1;
+  return s > 1000 ? 1000 : s;
+}
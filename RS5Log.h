@@ -0,0 +1,98 @@
+// ============================================================================
+// File: RS5Log.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Category logging with a compile time ceiling, categories that
+//              are not compiled in generate no code and no branches
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Log Categories and Levels
+enum logCategory {
+  LogBoot = 0,   // Startup messages
+  LogDMX,        // DMX frames and signal
+  LogServo,      // Debug servo tracking
+  LogModel,      // Motion model, every servo every tick
+  LogPower,      // Servo voltage and current
+  LogPixel,      // Eye and status pixels
+  LogCategoryCount
+};
+
+enum logLevel {
+  LogError = 0,
+  LogWarn,
+  LogInfo,
+  LogDebug
+};
+
+#define LOG_BIT(c)  (1u << (c))
+#define LOG_ALL     (LOG_BIT(LogCategoryCount) - 1)
+
+//**********************************************************************************
+// Compile Time Ceiling
+//
+// RS5_LOG_MASK selects the categories compiled in, RS5_LOG_CEILING the most
+// verbose level compiled in. Anything outside them folds to nothing, e.g. a
+// show build can use
+//   #define RS5_LOG_MASK LOG_BIT(LogBoot)
+// to strip all run loop logging.
+#ifndef RS5_LOG_MASK
+#define RS5_LOG_MASK LOG_ALL
+#endif
+
+#ifndef RS5_LOG_CEILING
+#define RS5_LOG_CEILING LogDebug
+#endif
+
+// Runtime mask and level, only consulted for categories that are compiled in
+uint32_t logMask = 0;
+uint8_t logLevelNow = LogInfo;
+
+constexpr bool logCompiled(uint8_t category, uint8_t level) {
+  return (RS5_LOG_MASK & LOG_BIT(category)) && level <= RS5_LOG_CEILING;
+}
+
+//**********************************************************************************
+// Log<Category, Level>
+//
+//   Log<LogDMX>::printf("No DMX:%d\n", status);
+//   if constexpr (Log<LogModel>::compiled) { ... }
+template<uint8_t Category, uint8_t Level = LogInfo>
+struct Log {
+  static constexpr bool compiled = logCompiled(Category, Level);
+
+  static inline bool enabled() {
+    if constexpr (!compiled) return false;
+    else return (logMask & LOG_BIT(Category)) && Level <= logLevelNow;
+  }
+
+  template<typename... Args>
+  static inline void printf(const char* fmt, Args... args) {
+    if constexpr (compiled) {
+      if (enabled()) Serial.printf(fmt, args...);
+    }
+  }
+};
+
+//**********************************************************************************
+// Runtime mask for the classic debug levels (RS5DMX.h debugLevel)
+void logSetDebugLevel(int level) {
+  logLevelNow = LogInfo;
+  switch (level) {
+    case DebugLevelNone: logMask = 0; break;
+    case DebugLevelStartup: logMask = LOG_BIT(LogBoot); break;
+    case DebugLevelDMX: logMask = LOG_BIT(LogBoot) | LOG_BIT(LogDMX); break;
+    case DebugLevelServo: logMask = LOG_BIT(LogBoot) | LOG_BIT(LogServo); break;
+    case DebugLevelModel: logMask = LOG_BIT(LogBoot) | LOG_BIT(LogModel); break;
+    case DebugLevelVoltCurrent: logMask = LOG_BIT(LogBoot) | LOG_BIT(LogPower); break;
+    case DebugLevelPixel: logMask = LOG_BIT(LogBoot) | LOG_BIT(LogPixel); break;
+    case DebugLevelServoFull:
+      logMask = LOG_BIT(LogBoot) | LOG_BIT(LogServo);
+      logLevelNow = LogDebug;
+      break;
+    default: logMask = LOG_ALL; break;
+  }
+}
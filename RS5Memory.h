@@ -0,0 +1,144 @@
+// ============================================================================
+// File: RS5Memory.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Memory monitor, task stack high water marks, heap use and
+//              fragmentation, static RAM by subsystem, low margin warnings
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <malloc.h>
+
+//**********************************************************************************
+// Memory Monitor
+//
+// Tasks are registered with memoryWatchTask(), loop() and loop1() from their
+// setup and the telemetry task once it is started. memoryCheck() runs from
+// loop() and, once every MEMORY_CHECK_PERIOD ms, compares each stack high
+// water mark and the free heap against the warning margins. A stack warning
+// is printed once per task (a high water mark never recovers), the heap
+// warning again each time free heap drops back under the margin. The
+// console 'm' key prints the full report.
+#define MEMORY_MAX_TASKS     8
+#define MEMORY_CHECK_PERIOD  1000   // ms
+#define MEMORY_STACK_WARN    256    // bytes of stack never touched
+#define MEMORY_HEAP_WARN     16384  // bytes of heap free
+
+// Linker symbols (pico SDK memmap)
+extern char __data_start__, __data_end__;
+extern char __bss_start__, __bss_end__;
+
+struct MemoryTask {
+  const char* name;
+  TaskHandle_t handle;
+  bool warned;
+};
+
+// Static RAM used by one subsystem, listed by the sketch
+struct MemoryRegion {
+  const char* name;
+  uint32_t bytes;
+};
+
+class MemoryMonitor {
+public:
+  MemoryTask task[MEMORY_MAX_TASKS];
+  int taskCount;
+  uint32_t lastCheck;
+  bool heapWarned;
+
+public:
+  MemoryMonitor() {
+    taskCount = 0;
+    lastCheck = 0;
+    heapWarned = false;
+  }
+
+public:
+
+  // Called during boot, core 0 from setup() and core 1 once core 0 is in loop()
+  void watch(const char* name, TaskHandle_t handle) {
+    if (handle == NULL || taskCount >= MEMORY_MAX_TASKS) return;
+    task[taskCount].name = name;
+    task[taskCount].handle = handle;
+    task[taskCount].warned = false;
+    taskCount++;
+  }
+
+  // Bytes of the task stack that have never been used
+  uint32_t stackFree(int t) {
+    return uxTaskGetStackHighWaterMark(task[t].handle) * sizeof(StackType_t);
+  }
+
+  // Largest block malloc() can hand out now, found by halving, slow so only
+  // used for the report
+  static uint32_t largestFreeBlock() {
+    uint32_t lo = 0;
+    uint32_t hi = rp2040.getFreeHeap();
+    while (lo < hi) {
+      uint32_t mid = (lo + hi + 1) / 2;
+      void* p = malloc(mid);
+      if (p != NULL) {
+        free(p);
+        lo = mid;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return lo;
+  }
+
+  void check() {
+    uint32_t now = millis();
+    if (now - lastCheck < MEMORY_CHECK_PERIOD) return;
+    lastCheck = now;
+
+    for (int t = 0; t < taskCount; t++) {
+      uint32_t margin = stackFree(t);
+      if (margin < MEMORY_STACK_WARN && !task[t].warned) {
+        Serial.printf("WARNING: task %s stack margin %lu bytes\n", task[t].name, (unsigned long)margin);
+        task[t].warned = true;
+      }
+    }
+
+    uint32_t heap = rp2040.getFreeHeap();
+    if (heap < MEMORY_HEAP_WARN && !heapWarned) {
+      Serial.printf("WARNING: heap free %lu bytes\n", (unsigned long)heap);
+      heapWarned = true;
+    } else if (heap >= MEMORY_HEAP_WARN) {
+      heapWarned = false;
+    }
+  }
+
+  void dump(const MemoryRegion* region, int regions) {
+    Serial.printf("Stacks (bytes never used):\n");
+    for (int t = 0; t < taskCount; t++) Serial.printf("  %-12s %6lu\n", task[t].name, (unsigned long)stackFree(t));
+
+    struct mallinfo mi = mallinfo();
+    uint32_t freeHeap = rp2040.getFreeHeap();
+    uint32_t largest = largestFreeBlock();
+    uint32_t frag = freeHeap ? 100 - (uint64_t)largest * 100 / freeHeap : 0;
+    Serial.printf("Heap: total %d, used %d, free %lu, largest block %lu, fragmentation %lu%%\n",
+                  rp2040.getTotalHeap(), rp2040.getUsedHeap(), (unsigned long)freeHeap, (unsigned long)largest, (unsigned long)frag);
+    Serial.printf("  arena %lu, in use %lu, free chunks %lu bytes\n", (unsigned long)mi.arena, (unsigned long)mi.uordblks, (unsigned long)mi.fordblks);
+
+    Serial.printf("Static RAM: data %lu, bss %lu\n", (unsigned long)(&__data_end__ - &__data_start__), (unsigned long)(&__bss_end__ - &__bss_start__));
+    for (int r = 0; r < regions; r++) Serial.printf("  %-12s %6lu\n", region[r].name, (unsigned long)region[r].bytes);
+  }
+};
+
+MemoryMonitor memoryMonitor;
+
+//**********************************************************************************
+// Hooks for the sketch
+void memoryWatchTask(const char* name, TaskHandle_t handle) {
+  memoryMonitor.watch(name, handle);
+}
+
+void memoryCheck() {
+  memoryMonitor.check();
+}
@@ -0,0 +1,200 @@
+// ============================================================================
+// File: RS5Pixels.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Dirty-tracked NeoPixel frame that sits in front of the
+//              Adafruit strip so redundant writes and refreshes are dropped
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <Adafruit_NeoPixel.h>
+
+static_assert(NUMPIXELS <= 32, "PixelFrame tracks dirty pixels in a 32 bit mask");
+
+//**********************************************************************************
+// Pixel Frame
+//
+// All status, servo and eye code writes into the frame instead of the strip.
+// Each pixel has a colour and a level (0-255). The level is applied when the
+// pixel is copied to the strip, so dimming never touches the stored colour
+// (Adafruit's setBrightness() rescales its buffer and loses precision).
+// A pixel is dirty when its scaled value differs from what was last
+// transmitted, so writing the same value again (or flipping a pixel and back
+// before the next refresh) costs nothing. The frame flag is set by writers and
+// cleared by the flush, which only touches the strip when a pixel changed.
+class PixelFrame {
+public:
+  uint32_t color[NUMPIXELS];  // Colour the effects want on each pixel (packed as pixels.Color())
+  uint8_t level[NUMPIXELS];   // Per pixel brightness, 255 = as stored
+  uint32_t shown[NUMPIXELS];  // Scaled colour last sent to the strip
+  volatile bool frameDirty;   // Something was written since the last flush
+  uint32_t frameCount;        // Number of frames transmitted
+  uint32_t skipCount;         // Number of flushes that found nothing to send
+
+public:
+  PixelFrame() {
+    for (int i = 0; i < NUMPIXELS; i++) {
+      color[i] = 0;
+      level[i] = 255;
+      shown[i] = 0xFFFFFFFF;  // Never a real colour, so the first flush sends every pixel
+    }
+    frameDirty = true;
+    frameCount = 0;
+    skipCount = 0;
+  }
+
+public:
+
+  // Set a pixel, returns true if the colour changed
+  bool setPixel(int n, uint32_t c) {
+    if (n < 0 || n >= NUMPIXELS) return false;
+    if (color[n] == c) return false;
+    color[n] = c;
+    frameDirty = true;
+    return true;
+  }
+
+  uint32_t getPixel(int n) {
+    if (n < 0 || n >= NUMPIXELS) return 0;
+    return color[n];
+  }
+
+  // Set a pixel level, returns true if it changed
+  bool setLevel(int n, uint8_t l) {
+    if (n < 0 || n >= NUMPIXELS) return false;
+    if (level[n] == l) return false;
+    level[n] = l;
+    frameDirty = true;
+    return true;
+  }
+
+  uint8_t getLevel(int n) {
+    if (n < 0 || n >= NUMPIXELS) return 0;
+    return level[n];
+  }
+
+  bool isDirty() {
+    return frameDirty;
+  }
+
+  // Colour as it goes on the wire, each channel scaled by the pixel level
+  uint32_t scaled(int n) {
+    uint32_t c = color[n];
+    uint32_t l = level[n];
+    if (l == 255) return c;
+    uint32_t a = (((c >> 16) & 0xFF) * (l + 1)) >> 8;
+    uint32_t b = (((c >> 8) & 0xFF) * (l + 1)) >> 8;
+    uint32_t d = ((c & 0xFF) * (l + 1)) >> 8;
+    return (a << 16) | (b << 8) | d;
+  }
+
+  // Mask of pixels whose scaled colour differs from what the strip is showing
+  uint32_t dirtyPixels() {
+    uint32_t mask = 0;
+    for (int i = 0; i < NUMPIXELS; i++) {
+      if (scaled(i) != shown[i]) mask |= (1u << i);
+    }
+    return mask;
+  }
+
+  // Copy changed pixels to the strip and transmit. Returns true if show() ran.
+  bool flush(Adafruit_NeoPixel& strip) {
+    if (!frameDirty) return false;
+    frameDirty = false;  // Clear before reading so a write racing the flush re-arms it
+
+    uint32_t mask = dirtyPixels();
+    if (mask == 0) {
+      skipCount++;
+      return false;
+    }
+
+    for (int i = 0; i < NUMPIXELS; i++) {
+      if (mask & (1u << i)) {
+        uint32_t c = scaled(i);
+        strip.setPixelColor(i, c);
+        shown[i] = c;
+      }
+    }
+    strip.show();
+    frameCount++;
+    return true;
+  }
+};
+
+PixelFrame pixelFrame;  // Render frame, written by the effects on core 0
+
+//**********************************************************************************
+// Pixel Exchange
+//
+// Double buffered hand off of a rendered frame from core 0 (effects) to core 1
+// (strip output). Core 0 writes the buffer core 1 is not reading and then bumps
+// the sequence number; core 1 copies the buffer named by the sequence and
+// retries if core 0 published again while it was copying.
+class PixelExchange {
+public:
+  uint32_t color[2][NUMPIXELS];  // Published frames
+  uint8_t level[2][NUMPIXELS];   // Published pixel levels
+  volatile uint32_t seq;         // Frames published, low bit selects the current buffer
+  uint32_t lastSeq;              // Last frame collected by the output core
+
+public:
+  PixelExchange() {
+    for (int b = 0; b < 2; b++) {
+      for (int i = 0; i < NUMPIXELS; i++) {
+        color[b][i] = 0;
+        level[b][i] = 255;
+      }
+    }
+    seq = 0;
+    lastSeq = 0;
+  }
+
+public:
+
+  // Core 0: publish the render frame if anything in it changed
+  bool publish(PixelFrame& src) {
+    if (!src.frameDirty) return false;
+    src.frameDirty = false;
+
+    uint32_t next = seq + 1;
+    int b = next & 1;
+    for (int i = 0; i < NUMPIXELS; i++) {
+      color[b][i] = src.color[i];
+      level[b][i] = src.level[i];
+    }
+    __sync_synchronize();  // Frame data must land before the sequence moves
+    seq = next;
+    return true;
+  }
+
+  // Core 1: copy the newest published frame into the output frame
+  bool collect(PixelFrame& dst) {
+    uint32_t s = seq;
+    if (s == lastSeq) return false;
+
+    uint32_t c[NUMPIXELS];
+    uint8_t l[NUMPIXELS];
+    do {
+      s = seq;
+      __sync_synchronize();
+      int b = s & 1;
+      for (int i = 0; i < NUMPIXELS; i++) {
+        c[i] = color[b][i];
+        l[i] = level[b][i];
+      }
+      __sync_synchronize();
+    } while (s != seq);  // Core 0 published mid copy, take the newer frame
+
+    for (int i = 0; i < NUMPIXELS; i++) {
+      dst.setPixel(i, c[i]);
+      dst.setLevel(i, l[i]);
+    }
+    lastSeq = s;
+    return true;
+  }
+};
+
+PixelFrame outputFrame;      // Core 1 copy of the frame that gets flushed to the strip
+PixelExchange pixelExchange;
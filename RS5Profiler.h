@@ -0,0 +1,151 @@
+// ============================================================================
+// File: RS5Profiler.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Per stage hot path profiler, min/avg/max and log2 histograms
+//              timed with the RP2040 microsecond timer
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <hardware/timer.h>
+
+//**********************************************************************************
+// Set RS5_PROFILER to 0 to compile the profiler out. PROFILE_STAGE() then
+// expands to nothing and no timer reads or counters are left in the loops.
+#ifndef RS5_PROFILER
+#define RS5_PROFILER 1
+#endif
+
+#define PROFILER_BUCKETS 16  // Bucket b holds durations of 2^(b-1) to 2^b - 1 us, the last one everything longer
+
+// Profiled stages. Each stage is only ever timed from one core, so the
+// counters need no locking; a dump from the other core may see a sample
+// half recorded, which is fine for statistics.
+enum profileStage {
+  ProfileLoop0 = 0,        // Core 0: one pass of loop()
+  ProfileReadDMX,          // Core 0: readDMX()
+  ProfileDipSwitches,      // Core 0: ReadDmxDipSwitches()
+  ProfileRenderEyes,       // Core 0: renderEyes()
+  ProfileServoMonitor,     // Core 0: servoMonitor()
+  ProfileLoop1,            // Core 1: one pass of the loop1() run loop
+  ProfileServoPositions,   // Core 1: setServoPositions()
+  ProfilePixelFrame,       // Core 1: sendPixelFrame()
+  ProfileDebugHooks,       // Core 1: servoTracker(), servoTrackerLite(), CheckCurrent()
+  ProfileProgram,          // Core 0: programPoll(), choreography decode and targets
+  ProfileTeach,            // Core 0: teachPoll(), teach-in encode and flash writes
+  ProfileStageCount
+};
+
+const char* profileStageName[ProfileStageCount] = {
+  "loop0", "readDMX", "dipSwitches", "renderEyes", "servoMonitor",
+  "loop1", "setServoPositions", "sendPixelFrame", "debugHooks", "program", "teach"
+};
+
+//**********************************************************************************
+// Statistics for one stage
+class ProfileStat {
+public:
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t totalUs;
+  uint32_t bucket[PROFILER_BUCKETS];
+
+public:
+  ProfileStat() {
+    reset();
+  }
+
+public:
+
+  void reset() {
+    count = 0;
+    minUs = 0xFFFFFFFF;
+    maxUs = 0;
+    totalUs = 0;
+    for (int b = 0; b < PROFILER_BUCKETS; b++) bucket[b] = 0;
+  }
+
+  void record(uint32_t us) {
+    count++;
+    totalUs += us;
+    if (us < minUs) minUs = us;
+    if (us > maxUs) maxUs = us;
+    int b = (us == 0) ? 0 : 32 - __builtin_clz(us);
+    if (b >= PROFILER_BUCKETS) b = PROFILER_BUCKETS - 1;
+    bucket[b]++;
+  }
+
+  uint32_t avgUs() {
+    return count ? (uint32_t)(totalUs / count) : 0;
+  }
+
+  // Upper edge (us) of the bucket holding the given percentile
+  uint32_t percentileUs(int pct) {
+    uint32_t want = ((uint64_t)count * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (int b = 0; b < PROFILER_BUCKETS; b++) {
+      seen += bucket[b];
+      if (seen >= want && seen > 0) return (1u << b) - 1;
+    }
+    return maxUs;
+  }
+
+  void print(const char* name) {
+    Serial.printf("%-18s n:%lu min:%lu avg:%lu p99<=%lu max:%lu |", name, (unsigned long)count,
+                  (unsigned long)(count ? minUs : 0), (unsigned long)avgUs(), (unsigned long)percentileUs(99), (unsigned long)maxUs);
+    for (int b = 0; b < PROFILER_BUCKETS; b++) Serial.printf(" %lu", (unsigned long)bucket[b]);
+    Serial.printf("\n");
+  }
+};
+
+#if RS5_PROFILER
+
+ProfileStat profileStat[ProfileStageCount];
+
+//**********************************************************************************
+// Times the enclosing block and records it against a stage
+class ProfileScope {
+public:
+  uint8_t stage;
+  uint32_t start;
+
+public:
+  ProfileScope(uint8_t s) {
+    stage = s;
+    start = time_us_32();
+  }
+
+  ~ProfileScope() {
+    profileStat[stage].record(time_us_32() - start);
+  }
+};
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_STAGE(stage) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(stage)
+
+void profilerReset() {
+  for (int i = 0; i < ProfileStageCount; i++) profileStat[i].reset();
+}
+
+void profilerDump() {
+  Serial.printf("Profiler (us), histogram buckets <1,<2,<4,<8...:\n");
+  for (int i = 0; i < ProfileStageCount; i++) profileStat[i].print(profileStageName[i]);
+}
+
+#else
+
+#define PROFILE_STAGE(stage) \
+  do { \
+  } while (0)
+
+void profilerReset() {}
+
+void profilerDump() {
+  Serial.printf("Profiler compiled out (RS5_PROFILER 0)\n");
+}
+
+#endif
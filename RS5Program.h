@@ -0,0 +1,388 @@
+// ============================================================================
+// File: RS5Program.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Standalone choreography, a keyframe program read in place from
+//              flash and played into the servo targets and eye preset
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Choreography Program (FLASH_PROGRAM_OFFSET)
+//
+// A ProgramHeader followed by a stream of events in time order. Each event
+// starts a ramp on one track: the servo axes in axis order, then the eye
+// preset. Levels are DMX values, so a program drives the skull exactly as a
+// console would on its channels:
+//
+//   varint  delta ms since the previous event
+//   uint8   track (bits 0-3) | curve (bits 4-7)
+//   uint8   level 0-255
+//   varint  ramp ms, only when the curve is not ProgramStep
+//
+// Recorded takes (ProgramFrames, RS5Teach.h) hold sampled DMX frames instead,
+// delta and run length coded. Frames where no track changed are left out and
+// the time delta spans them:
+//
+//   varint  delta ms since the previous frame
+//   uint8   mask, bit k set when track k changed
+//   varint  zigzag level change for each set bit, from 0 before the first frame
+//
+// The player keeps one decoded event of lookahead and reads the stream through
+// XIP, nothing is copied or allocated. Event times are absolute program time,
+// a ramp starts from the level its track had at the event's time, and a loop
+// pass moves the time base by exactly durationMs, so timing does not drift
+// with the loop() pass rate. extras/tools/program_compile.py builds programs
+// from text.
+#ifndef RS5_PROGRAM
+#define RS5_PROGRAM 1
+#endif
+
+#define PROGRAM_MAGIC         0x50355352  // "RS5P"
+#define PROGRAM_VERSION       1
+#define PROGRAM_TRACKS        (NUM_LIC_SERVOS + 1)  // Servo axes, then the eye preset
+#define PROGRAM_TRACK_EYES    NUM_LIC_SERVOS
+#define PROGRAM_DURATION_MAX  3600000     // ms, program time is kept in uint32 microseconds
+
+#ifndef PROGRAM_AUTOSTART_MS
+#define PROGRAM_AUTOSTART_MS  0           // Play the program after this long without DMX, 0 never
+#endif
+
+enum programCurve {
+  ProgramStep = 0,     // Jump to the level
+  ProgramLinear = 1,
+  ProgramEase = 2,     // Smoothstep, eases in and out
+  ProgramEaseIn = 3,   // Quadratic
+  ProgramEaseOut = 4,
+  ProgramCurveCount
+};
+
+enum programFlags {
+  ProgramLoop = 0x01,   // Start over after durationMs
+  ProgramFrames = 0x02  // Events are recorded frames
+};
+
+struct ProgramHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t flags;       // programFlags
+  uint32_t durationMs;  // One pass, the loop point
+  uint32_t length;      // Bytes of events after the header
+  uint32_t crc;         // CRC-32 of the events
+};
+
+//**********************************************************************************
+// One ramp per track, levels in 8.8 fixed point
+class ProgramTrack {
+public:
+  uint16_t from;
+  uint16_t to;
+  uint32_t startUs;  // Program time the ramp starts
+  uint32_t rampUs;
+  uint8_t curve;
+  bool set;          // No level until the track's first event
+
+public:
+  ProgramTrack() {
+    from = 0;
+    to = 0;
+    startUs = 0;
+    rampUs = 0;
+    curve = ProgramStep;
+    set = false;
+  }
+
+public:
+
+  // Level at program time t
+  uint16_t at(uint32_t t) {
+    if (curve == ProgramStep || rampUs == 0) return to;
+    if (t <= startUs) return from;
+    if (t - startUs >= rampUs) return to;
+    uint32_t p = ((uint64_t)(t - startUs) << 16) / rampUs;  // Progress, Q16
+    uint32_t s = p;
+    if (curve == ProgramEase) s = (uint32_t)(((uint64_t)p * p >> 16) * (3 * 65536 - 2 * p) >> 16);
+    else if (curve == ProgramEaseIn) s = (uint64_t)p * p >> 16;
+    else if (curve == ProgramEaseOut) s = 65536 - (uint32_t)((uint64_t)(65536 - p) * (65536 - p) >> 16);
+    return from + (((int32_t)to - (int32_t)from) * (int64_t)s >> 16);
+  }
+};
+
+//**********************************************************************************
+// Player, core 0 decodes and writes targets, core 1 moves the servos
+class ProgramPlayer {
+public:
+  const uint8_t* events;  // In flash
+  uint32_t length;
+  uint32_t durationUs;
+  bool loop;
+  bool frames;            // ProgramFrames coding
+  bool loaded;
+  bool active;
+  bool autostarted;       // Started by PROGRAM_AUTOSTART_MS, DMX takes back over
+  uint32_t startUs;       // time_us_32() at program time 0 of this pass
+  uint32_t pos;           // Offset of the next undecoded event
+  uint32_t timeUs;        // Program time of the last decoded event
+  bool pending;           // Decoded, waiting for its time
+  uint8_t nextTrack;
+  uint8_t nextCurve;
+  uint8_t nextLevel;
+  uint32_t nextRampUs;
+  uint8_t nextMask;                  // ProgramFrames: tracks set by the pending frame
+  uint8_t frameLevel[PROGRAM_TRACKS];  // ProgramFrames: levels after the pending frame
+  ProgramTrack track[PROGRAM_TRACKS];
+  uint16_t written[PROGRAM_TRACKS];  // Last level written to each target
+  uint32_t passes;
+  uint32_t applied;
+
+public:
+  ProgramPlayer() {
+    events = NULL;
+    length = 0;
+    durationUs = 0;
+    loop = false;
+    frames = false;
+    loaded = false;
+    active = false;
+    autostarted = false;
+    startUs = 0;
+    pos = 0;
+    timeUs = 0;
+    pending = false;
+    nextTrack = 0;
+    nextCurve = 0;
+    nextLevel = 0;
+    nextRampUs = 0;
+    nextMask = 0;
+    passes = 0;
+    applied = 0;
+  }
+
+public:
+
+  // Validate a program in place, the events are walked once so playback can
+  // trust them. Returns false and stays unloaded if anything is off.
+  bool load(const uint8_t* blob, uint32_t size) {
+    loaded = false;
+    const ProgramHeader* h = (const ProgramHeader*)blob;
+    if (size < sizeof(ProgramHeader) || h->magic != PROGRAM_MAGIC || h->version != PROGRAM_VERSION) return false;
+    if (h->length == 0 || h->length > size - sizeof(ProgramHeader)) return false;
+    if (h->durationMs == 0 || h->durationMs > PROGRAM_DURATION_MAX) return false;
+    events = blob + sizeof(ProgramHeader);
+    length = h->length;
+    if (crc32(events, length) != h->crc) return false;
+    durationUs = h->durationMs * 1000;
+    loop = h->flags & ProgramLoop;
+    frames = h->flags & ProgramFrames;
+
+    rewind();
+    while (pending) {
+      if (nextTrack >= PROGRAM_TRACKS || nextCurve >= ProgramCurveCount) return false;
+      pending = decode();
+    }
+    if (pos != length) return false;  // Truncated event
+    loaded = true;
+    return true;
+  }
+
+  // Read a LEB128 varint at pos
+  bool varint(uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+      if (pos >= length) return false;
+      uint8_t b = events[pos++];
+      v |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+
+  // Decode the event at pos into next*, false at the end of the stream
+  bool decode() {
+    if (frames) return decodeFrame();
+    uint32_t deltaMs;
+    uint32_t rampMs = 0;
+    if (pos >= length || !varint(deltaMs) || pos + 2 > length) return false;
+    nextTrack = events[pos] & 0x0F;
+    nextCurve = events[pos] >> 4;
+    nextLevel = events[pos + 1];
+    pos += 2;
+    if (nextCurve != ProgramStep && !varint(rampMs)) return false;
+    if (deltaMs > (durationUs - timeUs) / 1000 || rampMs > PROGRAM_DURATION_MAX) return false;  // Past the end of the pass
+    timeUs += deltaMs * 1000;
+    nextRampUs = rampMs * 1000;
+    return true;
+  }
+
+  // Decode a ProgramFrames frame into nextMask and frameLevel
+  bool decodeFrame() {
+    uint32_t deltaMs;
+    if (pos >= length || !varint(deltaMs) || pos >= length) return false;
+    nextMask = events[pos++];
+    if (nextMask == 0 || nextMask >> PROGRAM_TRACKS) return false;
+    for (int k = 0; k < PROGRAM_TRACKS; k++) {
+      if (!(nextMask & (1 << k))) continue;
+      uint32_t z;
+      if (!varint(z)) return false;
+      int v = frameLevel[k] + ((z & 1) ? -(int)(z >> 1) - 1 : (int)(z >> 1));
+      if (v < 0 || v > 255) return false;
+      frameLevel[k] = v;
+    }
+    if (deltaMs > (durationUs - timeUs) / 1000) return false;
+    timeUs += deltaMs * 1000;
+    return true;
+  }
+
+  void rewind() {
+    pos = 0;
+    timeUs = 0;
+    memset(frameLevel, 0, sizeof(frameLevel));
+    pending = decode();
+  }
+
+  void start(uint32_t nowUs) {
+    for (int k = 0; k < PROGRAM_TRACKS; k++) {
+      track[k] = ProgramTrack();
+      written[k] = 0xFFFF;
+    }
+    rewind();
+    startUs = nowUs;
+    passes = 0;
+    applied = 0;
+    active = true;
+  }
+
+  // Start the ramp of the pending event, from its track's level at that time
+  void apply() {
+    if (frames) {
+      for (int k = 0; k < PROGRAM_TRACKS; k++) {
+        if (!(nextMask & (1 << k))) continue;
+        track[k].to = frameLevel[k] << 8;
+        track[k].curve = ProgramStep;
+        track[k].set = true;
+      }
+      applied++;
+      return;
+    }
+    ProgramTrack& k = track[nextTrack];
+    k.from = k.set ? k.at(timeUs) : (uint16_t)(nextLevel << 8);
+    k.to = nextLevel << 8;
+    k.startUs = timeUs;
+    k.rampUs = nextRampUs;
+    k.curve = nextTrack == PROGRAM_TRACK_EYES ? (uint8_t)ProgramStep : nextCurve;  // Presets don't blend
+    k.set = true;
+    applied++;
+  }
+
+  // Apply the events that are due and return the program time to evaluate at
+  uint32_t advance(uint32_t nowUs) {
+    uint32_t t = nowUs - startUs;
+    while (true) {
+      while (pending && timeUs <= t) {
+        apply();
+        pending = decode();
+      }
+      if (t < durationUs) return t;
+      if (!loop) {
+        active = false;  // Hold the last levels
+        return durationUs;
+      }
+      // Next pass, whole passes keep the time base on the sample grid
+      for (int k = 0; k < PROGRAM_TRACKS; k++) {
+        if (track[k].set) {
+          track[k].from = track[k].at(durationUs);
+          track[k].to = track[k].from;
+          track[k].curve = ProgramStep;
+        }
+      }
+      startUs += durationUs;
+      t -= durationUs;
+      passes++;
+      rewind();
+    }
+  }
+
+  // Track level at program time t as a DMX value, -1 before its first event
+  int level(int k, uint32_t t) {
+    if (!track[k].set) return -1;
+    return (track[k].at(t) + 128) >> 8;
+  }
+};
+
+ProgramPlayer programPlayer;
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+
+// Check the program in flash, at boot and after a teach-in
+bool loadProgram() {
+#if RS5_PROGRAM
+  if (flashRegionAvailable(FLASH_PROGRAM_OFFSET, FLASH_PROGRAM_SIZE) && programPlayer.load(flashRegionAddr(FLASH_PROGRAM_OFFSET), FLASH_PROGRAM_SIZE)) {
+    Log<LogBoot>::printf("Core Zero: Program in flash, %lu bytes, %lu ms%s%s\n", (unsigned long)programPlayer.length,
+                         (unsigned long)(programPlayer.durationUs / 1000), programPlayer.loop ? ", loop" : "", programPlayer.frames ? ", recorded" : "");
+    return true;
+  }
+#endif
+  return false;
+}
+
+// Core 0 in RunModeProgram, writes the servo targets and returns the eye
+// preset DMX value, -1 while the program hasn't set one
+int programPoll() {
+#if RS5_PROGRAM
+  PROFILE_STAGE(ProfileProgram);
+  if (!programPlayer.loaded) return -1;
+  uint32_t t = programPlayer.active ? programPlayer.advance(time_us_32()) : programPlayer.durationUs;
+  for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+    int v = programPlayer.level(i, t);
+    if (v < 0 || v == programPlayer.written[i] || !C1_config_R[i].licensed) continue;
+    programPlayer.written[i] = v;
+    C1_run_R[i].settargetPos((float)v * (C1_config_R[i].maxDeg - C1_config_R[i].minDeg) / 255 + C1_config_R[i].minDeg);  // floatMap(v, 0, 255, ...) as readDMX()
+  }
+  return programPlayer.level(PROGRAM_TRACK_EYES, t);
+#else
+  return -1;
+#endif
+}
+
+void programStart(bool autostart) {
+#if RS5_PROGRAM
+  programPlayer.start(time_us_32());
+  programPlayer.autostarted = autostart;
+  systemState.setMode(RunModeProgram);
+  Serial.printf("Program playing%s\n", autostart ? ", no DMX" : "");
+#endif
+}
+
+void programStop() {
+#if RS5_PROGRAM
+  programPlayer.active = false;
+  systemState.setMode(RunModeDMX);
+  Serial.printf("Program stopped: passes:%lu events:%lu\n", (unsigned long)programPlayer.passes, (unsigned long)programPlayer.applied);
+#endif
+}
+
+// Console 'g'
+void programToggle() {
+#if RS5_PROGRAM
+  if (systemState.getMode() == RunModeProgram) programStop();
+  else if (programPlayer.loaded) programStart(false);
+  else Serial.printf("No program in flash\n");
+#else
+  Serial.printf("Program playback compiled out (RS5_PROGRAM 0)\n");
+#endif
+}
+
+// Core 0, once per loop() pass: play the program when DMX has been gone for
+// PROGRAM_AUTOSTART_MS and hand back when it returns
+void programAutostart() {
+#if RS5_PROGRAM
+  if (PROGRAM_AUTOSTART_MS == 0 || !programPlayer.loaded) return;
+  unsigned long age = millis() - dmxLastPacketMs();
+  int mode = systemState.getMode();
+  if (mode == RunModeDMX && age > PROGRAM_AUTOSTART_MS) programStart(true);
+  else if (mode == RunModeProgram && programPlayer.autostarted && age < (unsigned long)systemState.getDMXPacketAgeLimit()) programStop();
+#endif
+}
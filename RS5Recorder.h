@@ -0,0 +1,275 @@
+// ============================================================================
+// File: RS5Recorder.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Motion flight recorder, keeps the last few seconds of every
+//              axis in RAM and freezes on a trigger for a binary dump
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Flight Recorder
+//
+// setServoPositions() on core one samples target, position, velocity,
+// acceleration and PWM duty of every axis each RECORDER_PERIOD_US into a
+// ring of RECORDER_FRAMES samples. A sample is 4 + 10 bytes per axis, so
+// with NUM_LIC_SERVOS 6 the default ring is 1024 x 64 bytes, 5.1s of motion
+// in 64KB of RAM plus a few bytes of state. loop1() runs unpaced, so a
+// fixed sample period keeps the window length independent of loop speed;
+// 5ms is finer than any servo PWM period.
+//
+// A trigger (DMX loss, axis outside its travel, a stall, console 'f') records
+// RECORDER_POST_FRAMES more samples and then freezes the ring until it is
+// re-armed. Only core one changes the recorder state, other cores just post
+// a trigger reason.
+//
+// Console 'w' only starts the dump. The telemetry drain task sends it a
+// frame at a time while loop() sleeps, like any other telemetry, so writing
+// 64KB to USB never stalls readDMX().
+#ifndef RS5_RECORDER
+#define RS5_RECORDER 1
+#endif
+
+#ifndef RECORDER_FRAMES
+#define RECORDER_FRAMES       1024  // Power of two
+#endif
+#define RECORDER_PERIOD_US    5000
+#define RECORDER_POST_FRAMES  (RECORDER_FRAMES / 4)  // Samples kept after the trigger
+#ifndef RECORDER_RAM_MAX
+#define RECORDER_RAM_MAX      (65 * 1024)  // RAM budget above, raise it with RECORDER_FRAMES
+#endif
+
+#define RECORDER_MAGIC    0x46355352  // "RS5F"
+#define RECORDER_VERSION  1
+
+enum recorderState {
+  RecorderArmed = 0,
+  RecorderTriggered,  // Recording the post trigger samples
+  RecorderFrozen
+};
+
+enum recorderTrigger {
+  RecorderTriggerNone = 0,
+  RecorderTriggerDMXLoss,
+  RecorderTriggerLimit,
+  RecorderTriggerSerial,
+  RecorderTriggerStall
+};
+
+// One axis, fixed point so a sample is a handful of 16 bit stores
+struct RecorderAxis {
+  int16_t target;  // deg x10
+  int16_t pos;     // deg x10
+  int16_t vel;     // deg/s x10
+  int16_t acc;     // deg/s^2
+  uint16_t duty;   // % x100
+};
+
+struct RecorderSample {
+  uint32_t timeUs;
+  RecorderAxis axis[NUM_LIC_SERVOS];
+};
+
+// Dump header, sent before the samples
+struct RecorderHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t axes;
+  uint8_t trigger;       // recorderTrigger
+  uint8_t axisMask;      // Licensed axes
+  uint16_t frames;       // Samples that follow, oldest first
+  uint16_t triggerFrame; // Index of the trigger sample within them
+  uint32_t periodUs;
+};
+
+static_assert(sizeof(RecorderHeader) == 16, "RecorderHeader layout is read by extras/tools/flight_decode.py");
+static_assert(sizeof(RecorderSample) <= TELEMETRY_RECORD_MAX, "RecorderSample must fit a telemetry frame");
+
+#if RS5_RECORDER
+
+class FlightRecorder {
+public:
+  RecorderSample sample[RECORDER_FRAMES];
+  uint32_t head;                 // Samples written, core 1 only
+  uint32_t lastUs;
+  volatile uint8_t state;        // recorderState, written by core 1
+  volatile uint8_t pending;      // Trigger posted by any core
+  uint8_t trigger;               // Trigger that froze the ring
+  uint32_t triggerAt;            // head when the trigger was taken
+  uint16_t postLeft;
+  volatile bool rearm;
+  uint16_t dumpFrames;           // Samples in the dump being sent
+  volatile uint16_t dumpLeft;    // Frames the drain task still sends, header included, 0 idle
+
+public:
+  FlightRecorder() {
+    head = 0;
+    lastUs = 0;
+    state = RecorderArmed;
+    pending = RecorderTriggerNone;
+    trigger = RecorderTriggerNone;
+    triggerAt = 0;
+    postLeft = 0;
+    rearm = false;
+    dumpFrames = 0;
+    dumpLeft = 0;
+  }
+
+public:
+
+  // Any core. The first trigger wins until the recorder is re-armed.
+  void fire(uint8_t reason) {
+    if (state == RecorderArmed && pending == RecorderTriggerNone) pending = reason;
+  }
+
+  // Any core, takes effect on the next tick. Refused while a dump is being
+  // sent, core 1 would overwrite the samples under it.
+  bool arm() {
+    if (dumpLeft) return false;
+    rearm = true;
+    return true;
+  }
+
+  bool frozen() {
+    return state == RecorderFrozen;
+  }
+
+  // Core 1, start of a control tick. Returns the sample to fill or NULL when
+  // this tick is not sampled.
+  RecorderSample* beginTick() {
+    if (rearm) {
+      rearm = false;
+      pending = RecorderTriggerNone;
+      trigger = RecorderTriggerNone;
+      head = 0;
+      state = RecorderArmed;
+    }
+    if (state == RecorderFrozen) return NULL;
+    uint32_t now = time_us_32();
+    if (now - lastUs < RECORDER_PERIOD_US) return NULL;
+    lastUs = now;
+
+    if (state == RecorderArmed && pending != RecorderTriggerNone) {
+      trigger = pending;
+      triggerAt = head;
+      postLeft = RECORDER_POST_FRAMES;
+      state = RecorderTriggered;
+    }
+
+    RecorderSample* s = &sample[head & (RECORDER_FRAMES - 1)];
+    s->timeUs = now;
+    return s;
+  }
+
+  static inline void store(RecorderSample* s, int i, float target, float pos, float vel, float acc, float duty) {
+    RecorderAxis& a = s->axis[i];
+    a.target = target * 10;
+    a.pos = pos * 10;
+    a.vel = telemetryClamp(vel * 10);
+    a.acc = telemetryClamp(acc);
+    a.duty = duty * 100;
+  }
+
+  // Core 1, end of a sampled tick
+  void endTick() {
+    head++;
+    if (state == RecorderTriggered && --postLeft == 0) state = RecorderFrozen;
+  }
+
+  //********************************************************************************
+  // Binary dump, COBS framed like telemetry: a RecorderHeader frame, then
+  // one RecorderSample frame each, oldest first. Only while frozen; core 0
+  // starts it and the drain task sends it through nextFrame().
+  bool dump() {
+    if (state != RecorderFrozen) return false;
+    if (dumpLeft) return true;  // Already on its way
+    dumpFrames = head < RECORDER_FRAMES ? head : RECORDER_FRAMES;
+    dumpLeft = dumpFrames + 1;
+    telemetry.enable(TelemetryRecorder, true);  // The dump needs the drain task running
+    return true;
+  }
+
+  // Drain task, the next frame of the dump into telemetry.frame
+  bool nextFrame() {
+    if (dumpLeft == 0) return false;
+    if (dumpLeft == dumpFrames + 1) {
+      RecorderHeader h;
+      h.magic = RECORDER_MAGIC;
+      h.version = RECORDER_VERSION;
+      h.axes = NUM_LIC_SERVOS;
+      h.trigger = trigger;
+      h.axisMask = 0;
+      for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+        if (C1_config_R[i].licensed) h.axisMask |= 1 << i;
+      }
+      h.frames = dumpFrames;
+      h.triggerFrame = triggerAt - (head - dumpFrames);
+      h.periodUs = RECORDER_PERIOD_US;
+      telemetry.setFrame(&h, sizeof(h));
+    } else {
+      telemetry.setFrame(&sample[(head - dumpLeft) & (RECORDER_FRAMES - 1)], sizeof(RecorderSample));
+    }
+    if (--dumpLeft == 0) telemetry.enable(TelemetryRecorder, false);
+    return true;
+  }
+};
+
+FlightRecorder flightRecorder;
+
+static_assert(sizeof(FlightRecorder) <= RECORDER_RAM_MAX, "Flight recorder RAM over RECORDER_RAM_MAX, update the size stated above");
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+inline RecorderSample* recorderBeginTick() {
+#if RS5_RECORDER
+  return flightRecorder.beginTick();
+#else
+  return NULL;
+#endif
+}
+
+inline void recorderStore(RecorderSample* s, int i, float target, float pos, float vel, float acc, float duty) {
+#if RS5_RECORDER
+  FlightRecorder::store(s, i, target, pos, vel, acc, duty);
+#endif
+}
+
+inline void recorderEndTick() {
+#if RS5_RECORDER
+  flightRecorder.endTick();
+#endif
+}
+
+inline void recorderFire(uint8_t reason) {
+#if RS5_RECORDER
+  flightRecorder.fire(reason);
+#endif
+}
+
+void recorderArm() {
+#if RS5_RECORDER
+  if (flightRecorder.arm()) Serial.printf("Recorder armed\n");
+  else Serial.printf("Recorder dump in progress, arm again when it is sent\n");
+#endif
+}
+
+// Telemetry drain task, after command replies
+bool recorderNextFrame() {
+#if RS5_RECORDER
+  return flightRecorder.nextFrame();
+#else
+  return false;
+#endif
+}
+
+void recorderDump() {
+#if RS5_RECORDER
+  if (!flightRecorder.dump()) Serial.printf("Recorder not frozen, trigger with 'f' first\n");
+#else
+  Serial.printf("Recorder compiled out (RS5_RECORDER 0)\n");
+#endif
+}
@@ -0,0 +1,233 @@
+// ============================================================================
+// File: RS5Stall.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Stall and overload detection, a jammed servo is found by the
+//              supply current and rested through the PWM sleep path
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Stall Detection
+//
+// Hobby servos report nothing back, and the current sense sees the whole servo
+// supply. What the sketch does know is the motion it commands, so core 1
+// compares the current with what that motion should draw: STALL_IDLE_CURRENT
+// plus STALL_MOTION_CURRENT per 100 deg/s the enabled axes are moving. A servo
+// pushing against a jam draws its stall current while the motion engine says
+// it has arrived, so the current stays above the expectation. After
+// STALL_DETECT_MS over it by STALL_EXCESS the detector looks for the axis.
+//
+// The candidates are the axes with their PWM on, the one that moved last
+// first. Each is put to sleep for STALL_PROBE_MS, longer than the current
+// filter takes to follow; if the excess goes, that axis is the jammed one and
+// stays asleep for its rest time, otherwise it wakes and the next one is
+// tried. A sleeping servo is released, so an innocent axis goes limp for the
+// probe and then takes its target again. An axis stalling again within
+// STALL_FORGET_MS rests twice as long as last time, up to STALL_REST_MAX_MS.
+// When no axis clears it the excess counts as an overload, and the detector
+// waits STALL_REST_MS before it looks again.
+//
+// A resting axis is held asleep in setServoPositions() by the same PwmEnabled
+// path as the sleep timer; its motion engine keeps following the targets, so
+// after the rest it wakes the next time it has somewhere to go. Its status
+// pixel shows SERVO_STATUS_STALLED while it rests, and every stall freezes the
+// flight recorder.
+#ifndef RS5_STALL
+#define RS5_STALL 1
+#endif
+
+#define STALL_PERIOD_US       10000
+#define STALL_IDLE_CURRENT    400      // SERVO_CURRENT_LOW-HIGH scale, all servos holding still
+#define STALL_MOTION_CURRENT  150      // Added per 100 deg/s of commanded motion
+#define STALL_EXCESS          600      // Over the expectation by this counts
+#define STALL_DETECT_MS       500      // For this long before the axes are probed
+#define STALL_PROBE_MS        150      // Sleep per candidate, three times the current filter
+#define STALL_REST_MS         5000     // First rest of a stalled axis
+#define STALL_REST_MAX_MS     60000
+#define STALL_FORGET_MS       120000   // A stall longer ago than this no longer doubles the rest
+
+enum stallState {
+  StallWatch,  // Comparing current and motion
+  StallProbe,  // One candidate asleep
+  StallHold    // Overload nobody cleared, waiting
+};
+
+#if RS5_STALL
+
+//**********************************************************************************
+// Stall detector, core 1
+class StallDetector {
+public:
+  uint8_t state;
+  uint32_t lastUs;
+  uint32_t overMs;                       // Time the current has been over the expectation
+  uint32_t stateMs;                      // millis() the probe or hold started
+  int expected;                          // Last expectation
+  volatile uint16_t resting;             // Bit per axis held asleep, read by core 0
+  uint16_t tried;                        // Candidates probed this round
+  int probe;                             // Axis asleep for the probe, -1 none
+  uint32_t restUntil[NUM_LIC_SERVOS];
+  uint32_t restMs[NUM_LIC_SERVOS];       // Rest of the last stall
+  uint32_t lastStallMs[NUM_LIC_SERVOS];
+  uint32_t stalls[NUM_LIC_SERVOS];
+  uint32_t probes;
+  uint32_t overloads;
+
+public:
+  StallDetector() {
+    state = StallWatch;
+    lastUs = 0;
+    overMs = 0;
+    stateMs = 0;
+    expected = 0;
+    resting = 0;
+    tried = 0;
+    probe = -1;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      restUntil[i] = 0;
+      restMs[i] = 0;
+      lastStallMs[i] = 0;
+      stalls[i] = 0;
+    }
+    probes = 0;
+    overloads = 0;
+  }
+
+public:
+
+  bool enabled(int i) {
+    return C1_config_R[i].licensed && C1_run_R[i].PwmEnabled;
+  }
+
+  // What the commanded motion should draw
+  int expect() {
+    float speed = 0;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (enabled(i)) speed += fabsf(DL[i].getVelocity());
+    }
+    return STALL_IDLE_CURRENT + (int)(STALL_MOTION_CURRENT * speed / 100);
+  }
+
+  // Next axis to probe: enabled, not tried this round, the latest move first
+  int candidate() {
+    int best = -1;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (!enabled(i) || (tried & (1 << i)) || (resting & (1 << i))) continue;
+      if (best < 0 || C1_run_R[i].getlastMove() > C1_run_R[best].getlastMove()) best = i;
+    }
+    return best;
+  }
+
+  void startProbe(uint32_t now) {
+    probe = candidate();
+    if (probe < 0) {
+      overloads++;
+      Log<LogPower, LogWarn>::printf("Overload: current %d, expected %d, no axis cleared it\n", currentNow(), expected);
+      state = StallHold;
+      stateMs = now;
+      return;
+    }
+    tried |= 1 << probe;
+    resting |= 1 << probe;
+    probes++;
+    state = StallProbe;
+    stateMs = now;
+  }
+
+  void rest(int i, uint32_t now) {
+    bool again = stalls[i] && now - lastStallMs[i] < STALL_FORGET_MS;
+    restMs[i] = again ? min(restMs[i] * 2, (uint32_t)STALL_REST_MAX_MS) : STALL_REST_MS;
+    restUntil[i] = now + restMs[i];
+    lastStallMs[i] = now;
+    stalls[i]++;
+    recorderFire(RecorderTriggerStall);
+    Log<LogPower, LogWarn>::printf("Stall: servo %d resting %lums, %lu stalls\n", i, (unsigned long)restMs[i], (unsigned long)stalls[i]);
+  }
+
+  // dt: time since the last call
+  void apply(uint32_t dt) {
+    uint32_t now = millis();
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if ((resting & (1 << i)) && i != probe && (int32_t)(now - restUntil[i]) >= 0) resting &= ~(1 << i);
+    }
+
+    int current = currentNow();
+    switch (state) {
+      case StallWatch:
+        expected = expect();
+        if (current > expected + STALL_EXCESS) overMs += min(dt, (uint32_t)2 * STALL_PERIOD_US) / 1000;  // The first call's dt is the boot
+        else overMs = 0;
+        if (overMs < STALL_DETECT_MS) break;
+        overMs = 0;
+        tried = 0;
+        startProbe(now);
+        break;
+
+      case StallProbe:
+        if (now - stateMs < STALL_PROBE_MS) break;
+        if (current < expected + STALL_EXCESS / 2) {
+          rest(probe, now);  // Stays in resting
+          probe = -1;
+          state = StallWatch;
+          break;
+        }
+        resting &= ~(1 << probe);
+        probe = -1;
+        startProbe(now);
+        break;
+
+      case StallHold:
+        if (now - stateMs >= STALL_REST_MS) state = StallWatch;
+        break;
+    }
+  }
+
+  void print() {
+    Serial.printf("Stall: current %d, expected %d, %lu probes, %lu overloads\n", currentNow(), expected, (unsigned long)probes, (unsigned long)overloads);
+    Serial.printf("Stall: stalls");
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) Serial.printf(" %lu", (unsigned long)stalls[i]);
+    Serial.printf(", resting");
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (resting & (1 << i)) Serial.printf(" %d", i);
+    }
+    Serial.printf("\n");
+  }
+};
+
+StallDetector stallDetector;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, nothing rests when compiled out
+
+// Core 1 loop1(), after governorApply()
+inline void stallApply() {
+#if RS5_STALL
+  uint32_t now = time_us_32();
+  if (now - stallDetector.lastUs < STALL_PERIOD_US) return;
+  stallDetector.apply(now - stallDetector.lastUs);
+  stallDetector.lastUs = now;
+#endif
+}
+
+// setServoPositions() and servoMonitor(): axis i is held asleep
+inline bool stallResting(int i) {
+#if RS5_STALL
+  return stallDetector.resting & (1 << i);
+#else
+  return false;
+#endif
+}
+
+// Console j
+void stallReport() {
+#if RS5_STALL
+  stallDetector.print();
+#else
+  Serial.printf("Stall detection compiled out\n");
+#endif
+}
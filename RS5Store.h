@@ -0,0 +1,336 @@
+// ============================================================================
+// File: RS5Store.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Config store in flash, servo tuning, user eye presets and
+//              saved servo positions in one versioned, CRC checked image
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Config Store (FLASH_STORE_OFFSET)
+//
+// Two sectors used as a log of fixed size slots. A save writes the whole
+// StoreImage into the next blank slot with a sequence number one higher than
+// the newest, so the previous image stays valid until the new one is
+// completely programmed: a save cut short fails its CRC and boot falls back
+// to the one before. When a sector is full the next save erases the other
+// one, which spreads erases over both sectors and over time.
+//
+// At boot storeLoad() walks the slot headers in place through XIP, checks the
+// CRC of the newest and copies it into configStore.image in one struct copy. Sections
+// are only applied when their flag is set, everything else keeps the compiled
+// defaults from RS5Hardware.h and eyeLight[]. User eye presets from the old
+// FLASH_EYE_PRESET_OFFSET blob are taken over while the store holds none and
+// move into it with the next save.
+#ifndef RS5_STORE
+#define RS5_STORE 1
+#endif
+
+#define STORE_MAGIC          0x53355352  // "RS5S"
+#define STORE_VERSION        1
+#define STORE_EYE_PRESETS    16          // User presets, MAX_EYE_PRESETS less the built in ones
+#define STORE_POSITIONS      4           // Saved servo position slots
+
+enum storeFlags {
+  StoreServos = 0x01,  // servo[] replaces the compiled servo tuning
+  StoreEyes = 0x02     // eye[] replaces the presets in the legacy blob
+};
+
+struct StoreHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;  // sizeof(StoreImage), a changed layout needs a new version
+  uint32_t seq;   // Newest valid image wins
+  uint32_t crc;   // CRC-32 of everything after the header
+};
+
+// Servo tuning, the ServoConfig fields that are set per build
+struct StoreServo {
+  uint8_t smooth;
+  uint8_t reserved[3];
+  float minDeg;
+  float maxDeg;
+  float minPWM;
+  float maxPWM;
+  float maxVel;
+  float maxAcc;
+  float maxDec;
+  int32_t servoSleepTimer;
+};
+
+struct StorePosition {
+  uint8_t set;
+  uint8_t reserved[3];
+  float deg[NUM_SERVO_PINS];
+};
+
+struct StoreImage {
+  StoreHeader header;
+  uint16_t flags;     // storeFlags
+  uint16_t eyeCount;
+  uint32_t reserved;
+  StoreServo servo[NUM_SERVO_PINS];
+  EyePresetRecord eye[STORE_EYE_PRESETS];
+  StorePosition position[STORE_POSITIONS];
+};
+
+#define STORE_SLOT_SIZE         ((sizeof(StoreImage) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+#define STORE_SLOTS_PER_SECTOR  (FLASH_SECTOR_SIZE / STORE_SLOT_SIZE)
+#define STORE_SLOTS             (STORE_SLOTS_PER_SECTOR * FLASH_STORE_SIZE / FLASH_SECTOR_SIZE)
+
+static_assert(STORE_SLOTS_PER_SECTOR >= 1, "StoreImage must fit a flash sector");
+
+//**********************************************************************************
+// User eye presets in the legacy blob at FLASH_EYE_PRESET_OFFSET, read in place
+int legacyEyePresets(const EyePresetRecord*& records) {
+  if (!flashRegionAvailable(FLASH_EYE_PRESET_OFFSET, FLASH_EYE_PRESET_SIZE)) return 0;
+  const uint8_t* blob = flashRegionAddr(FLASH_EYE_PRESET_OFFSET);
+  const EyePresetBlobHeader* h = (const EyePresetBlobHeader*)blob;
+  if (h->magic != EYE_PRESET_MAGIC || h->version != EYE_PRESET_VERSION) return 0;
+  uint32_t bytes = (uint32_t)h->count * sizeof(EyePresetRecord);
+  if (h->count == 0 || sizeof(EyePresetBlobHeader) + bytes > FLASH_EYE_PRESET_SIZE) return 0;
+  records = (const EyePresetRecord*)(blob + sizeof(EyePresetBlobHeader));
+  if (crc32((const uint8_t*)records, bytes) != h->crc) return 0;
+  return h->count;
+}
+
+#if RS5_STORE
+
+//**********************************************************************************
+// Store, loaded on core 0 at boot, saved from the core 0 console
+class ConfigStore {
+public:
+  StoreImage image;  // RAM copy, what the next save writes
+  bool loaded;       // image came from flash
+  int slot;          // Slot of the newest image, -1 none
+
+public:
+  ConfigStore() {
+    memset(&image, 0, sizeof(image));
+    loaded = false;
+    slot = -1;
+  }
+
+public:
+
+  uint32_t slotOffset(int s) {
+    return FLASH_STORE_OFFSET + (s / STORE_SLOTS_PER_SECTOR) * FLASH_SECTOR_SIZE + (s % STORE_SLOTS_PER_SECTOR) * STORE_SLOT_SIZE;
+  }
+
+  uint32_t imageCrc(const StoreImage* p) {
+    return crc32((const uint8_t*)p + sizeof(StoreHeader), sizeof(StoreImage) - sizeof(StoreHeader));
+  }
+
+  // Newest slot whose header and CRC check out, read in place
+  void load() {
+    loaded = false;
+    slot = -1;
+    if (!flashRegionAvailable(FLASH_STORE_OFFSET, FLASH_STORE_SIZE)) return;
+    uint32_t bestSeq = 0;
+    for (int s = 0; s < (int)STORE_SLOTS; s++) {
+      const StoreImage* p = (const StoreImage*)flashRegionAddr(slotOffset(s));
+      const StoreHeader& h = p->header;
+      if (h.magic != STORE_MAGIC || h.version != STORE_VERSION || h.size != sizeof(StoreImage)) continue;
+      if (slot >= 0 && (int32_t)(h.seq - bestSeq) <= 0) continue;
+      if (imageCrc(p) != h.crc) continue;  // Cut short, the one before still counts
+      slot = s;
+      bestSeq = h.seq;
+    }
+    if (slot < 0) return;
+    image = *(const StoreImage*)flashRegionAddr(slotOffset(slot));  // One copy out of XIP
+    if (image.eyeCount > STORE_EYE_PRESETS) image.eyeCount = STORE_EYE_PRESETS;
+    loaded = true;
+  }
+
+  bool blank(int s) {
+    const uint8_t* p = flashRegionAddr(slotOffset(s));
+    for (uint32_t i = 0; i < STORE_SLOT_SIZE; i++) {
+      if (p[i] != 0xFF) return false;
+    }
+    return true;
+  }
+
+  // Write image into the slot after the newest one, false if flash is missing
+  bool save() {
+    if (!flashRegionAvailable(FLASH_STORE_OFFSET, FLASH_STORE_SIZE)) return false;
+    int s = slot;
+    do {
+      s = (s + 1) % STORE_SLOTS;
+      if (s % STORE_SLOTS_PER_SECTOR == 0) {
+        flashRegionErase(slotOffset(s), FLASH_SECTOR_SIZE);  // Never the sector holding the newest image
+        break;
+      }
+    } while (!blank(s));
+
+    image.header.magic = STORE_MAGIC;
+    image.header.version = STORE_VERSION;
+    image.header.size = sizeof(StoreImage);
+    image.header.seq = loaded ? image.header.seq + 1 : 1;
+    image.header.crc = imageCrc(&image);
+    uint32_t whole = sizeof(image) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+    uint8_t tail[FLASH_PAGE_SIZE];
+    memset(tail, 0xFF, sizeof(tail));
+    memcpy(tail, (const uint8_t*)&image + whole, sizeof(image) - whole);
+    if (whole) flashRegionProgram(slotOffset(s), (const uint8_t*)&image, whole);
+    if (whole < sizeof(image)) flashRegionProgram(slotOffset(s) + whole, tail, FLASH_PAGE_SIZE);
+
+    if (memcmp(flashRegionAddr(slotOffset(s)), &image, sizeof(image)) != 0) return false;
+    slot = s;
+    loaded = true;
+    return true;
+  }
+
+  // Erase both sectors, the compiled defaults apply from the next boot
+  void clear() {
+    if (!flashRegionAvailable(FLASH_STORE_OFFSET, FLASH_STORE_SIZE)) return;
+    for (uint32_t s = 0; s < FLASH_STORE_SIZE; s += FLASH_SECTOR_SIZE) flashRegionErase(FLASH_STORE_OFFSET + s, FLASH_SECTOR_SIZE);
+    memset(&image, 0, sizeof(image));
+    loaded = false;
+    slot = -1;
+  }
+
+  // Copy the running servo tuning into the image
+  void captureServos() {
+    for (int i = 0; i < NUM_SERVO_PINS; i++) {
+      StoreServo& d = image.servo[i];
+      ServoConfig& c = C1_config_R[i];
+      d.smooth = c.smooth;
+      d.minDeg = c.minDeg;
+      d.maxDeg = c.maxDeg;
+      d.minPWM = c.minPWM;
+      d.maxPWM = c.maxPWM;
+      d.maxVel = c.maxVel;
+      d.maxAcc = c.maxAcc;
+      d.maxDec = c.maxDec;
+      d.servoSleepTimer = c.servoSleepTimer;
+    }
+    image.flags |= StoreServos;
+  }
+
+  void applyServos() {
+    if (!(image.flags & StoreServos)) return;
+    for (int i = 0; i < NUM_SERVO_PINS; i++) {
+      const StoreServo& d = image.servo[i];
+      ServoConfig& c = C1_config_R[i];
+      c.smooth = d.smooth;
+      c.minDeg = d.minDeg;
+      c.maxDeg = d.maxDeg;
+      c.minPWM = d.minPWM;
+      c.maxPWM = d.maxPWM;
+      c.maxVel = d.maxVel;
+      c.maxAcc = d.maxAcc;
+      c.maxDec = d.maxDec;
+      c.servoSleepTimer = d.servoSleepTimer;
+      C1_run_R[i].servoSleepTimer = d.servoSleepTimer;
+    }
+  }
+
+  // Store presets, or the legacy blob's until the store has its own
+  void migrateEyes() {
+    if (image.flags & StoreEyes) return;
+    const EyePresetRecord* r;
+    int n = legacyEyePresets(r);
+    if (n > STORE_EYE_PRESETS) n = STORE_EYE_PRESETS;
+    memcpy(image.eye, r, n * sizeof(EyePresetRecord));
+    image.eyeCount = n;
+  }
+};
+
+ConfigStore configStore;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+
+// Core 0 setup(), before compileEyePresets()
+void storeLoad() {
+#if RS5_STORE
+  configStore.load();
+  configStore.migrateEyes();
+  if (configStore.loaded) {
+    Log<LogBoot>::printf("Core Zero: Config store seq %lu, slot %d%s%s\n", (unsigned long)configStore.image.header.seq, configStore.slot,
+                         (configStore.image.flags & StoreServos) ? ", servos" : "", (configStore.image.flags & StoreEyes) ? ", eyes" : "");
+  }
+#endif
+}
+
+// Core 1 setup1(), after the compiled defaults
+void storeApplyServos() {
+#if RS5_STORE
+  configStore.applyServos();
+#endif
+}
+
+// User eye presets for compileEyePresets()
+int storeEyePresets(const EyePresetRecord*& records) {
+#if RS5_STORE
+  records = configStore.image.eye;
+  return configStore.image.eyeCount;
+#else
+  return legacyEyePresets(records);
+#endif
+}
+
+// Console 'S': servo tuning and user eye presets as they run now
+bool storeSaveConfig() {
+#if RS5_STORE
+  configStore.captureServos();
+  configStore.image.flags |= StoreEyes;
+  bool ok = configStore.save();
+  Serial.printf("Config %s: seq:%lu slot:%d\n", ok ? "saved" : "save failed", (unsigned long)configStore.image.header.seq, configStore.slot);
+  return ok;
+#else
+  Serial.printf("Config store compiled out (RS5_STORE 0)\n");
+  return false;
+#endif
+}
+
+// Console 'Z'
+void storeClear() {
+#if RS5_STORE
+  configStore.clear();
+  Serial.printf("Config store cleared, defaults from the next boot\n");
+#else
+  Serial.printf("Config store compiled out (RS5_STORE 0)\n");
+#endif
+}
+
+// Console 'P': the servo positions into slot n
+bool storeSavePosition(int n) {
+#if RS5_STORE
+  if (n < 0 || n >= STORE_POSITIONS) return false;
+  StorePosition& p = configStore.image.position[n];
+  for (int i = 0; i < NUM_SERVO_PINS; i++) p.deg[i] = C1_run_R[i].getcurentPos();
+  p.set = 1;
+  bool ok = configStore.save();
+  Serial.printf("Position %d %s\n", n, ok ? "saved" : "save failed");
+  return ok;
+#else
+  Serial.printf("Config store compiled out (RS5_STORE 0)\n");
+  return false;
+#endif
+}
+
+// Console 'R': move to the positions in slot n. DMX frames and programs set
+// their own targets, so the pose holds while neither is running.
+bool storeRecallPosition(int n) {
+#if RS5_STORE
+  if (n < 0 || n >= STORE_POSITIONS || !configStore.image.position[n].set) {
+    Serial.printf("Position %d not saved\n", n);
+    return false;
+  }
+  const StorePosition& p = configStore.image.position[n];
+  for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+    if (C1_config_R[i].licensed) C1_run_R[i].settargetPos(constrain(p.deg[i], C1_config_R[i].minDeg, C1_config_R[i].maxDeg));
+  }
+  Serial.printf("Position %d recalled\n", n);
+  return true;
+#else
+  Serial.printf("Config store compiled out (RS5_STORE 0)\n");
+  return false;
+#endif
+}
@@ -0,0 +1,261 @@
+// ============================================================================
+// File: RS5Stream.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: USB streaming control (RunModeSerial), host target frames at
+//              up to 1kHz through a jitter buffer into the motion engine
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Streaming Control
+//
+// A host (show control, audio or video playback) sends StreamRecord frames on
+// the console: a sequence number, its own time stamp and a 16 bit level per
+// servo axis over minDeg-maxDeg, like a DMX channel with finer steps. The
+// first frame switches to RunModeSerial, DMX is ignored until the stream ends.
+//
+// Core 0 receives the frames and gives each a local due time: the host time
+// stamp relative to the first frame, STREAM_LEAD_US later than that frame
+// arrived. USB delivers in bursts, the lead absorbs them, so the servos follow
+// the host's timeline rather than the arrival times. Core 1 takes the due
+// frames at the top of each loop1() pass and writes the targets right before
+// setServoPositions(), the same path DMX targets take.
+//
+// Sequence gaps count as lost frames, repeated or older sequence numbers are
+// dropped. A frame that arrives after its due time moves the timeline later
+// by its lateness plus the lead, one that would sit more than twice the lead
+// in the buffer (a host clock running fast) moves it earlier; both count as
+// rebases. STREAM_TIMEOUT_MS without a frame, or a StreamEnd frame once
+// the buffer has played out, returns to RunModeDMX with a report.
+#ifndef RS5_STREAM
+#define RS5_STREAM 1
+#endif
+
+#define STREAM_RING_SIZE   64      // Frames queued for core 1, power of two, 64ms at 1kHz
+#define STREAM_LEAD_US     20000   // Jitter buffer
+#define STREAM_LATE_US     1000    // Applied later than this counts as late
+#define STREAM_TIMEOUT_MS  2000    // No frame for this long ends the stream
+
+enum streamFlags {
+  StreamEyes = 0x01,  // eyes carries an eye preset DMX value
+  StreamEnd = 0x02    // Last frame, levels ignored
+};
+
+struct StreamRecord {
+  uint8_t type;      // TelemetryStream
+  uint8_t flags;     // streamFlags
+  uint16_t seq;      // Host sequence, one per frame
+  uint32_t timeUs;   // Host time stamp, any base, wraps
+  uint8_t eyes;
+  uint8_t reserved;
+  uint16_t level[NUM_LIC_SERVOS];  // 0-65535 over minDeg-maxDeg
+};
+
+static_assert(sizeof(StreamRecord) <= TELEMETRY_RECORD_MAX, "StreamRecord must fit a console frame");
+
+// One frame on its way to core 1
+struct StreamSample {
+  uint16_t seq;      // Ring sequence
+  uint8_t flags;
+  uint8_t eyes;
+  uint32_t dueUs;    // time_us_32() it applies at
+  uint16_t level[NUM_LIC_SERVOS];
+};
+
+#if RS5_STREAM
+
+//**********************************************************************************
+// Stream, frames in on core 0, applied on core 1
+class StreamPlayer {
+public:
+  RecordRing<StreamSample, STREAM_RING_SIZE> ring;
+  bool active;
+  bool based;
+  uint32_t hostBase;      // Host time of the timeline origin
+  uint32_t localBase;     // Local time it applies at
+  uint16_t lastSeq;
+  uint32_t lastRecordMs;
+  volatile bool ended;    // Core 1 reached the StreamEnd frame
+  volatile int eyes;      // Eye preset value of the newest applied frame, -1 none
+  uint32_t frames;        // Queued, the StreamEnd frame excepted
+  volatile uint32_t played;
+  volatile uint32_t late;
+  uint32_t lost;          // Sequence gaps
+  uint32_t stale;         // Repeated or out of order
+  uint32_t overflow;
+  uint32_t rebased;
+  int32_t slackMinUs;     // Shortest time a frame waited in the buffer
+  int32_t slackMaxUs;
+
+public:
+  StreamPlayer() {
+    active = false;
+    based = false;
+    hostBase = 0;
+    localBase = 0;
+    lastSeq = 0;
+    lastRecordMs = 0;
+    ended = false;
+    eyes = -1;
+    frames = 0;
+    played = 0;
+    late = 0;
+    lost = 0;
+    stale = 0;
+    overflow = 0;
+    rebased = 0;
+    slackMinUs = 0;
+    slackMaxUs = 0;
+  }
+
+public:
+
+  void begin() {
+    if (systemState.getMode() == RunModeProgram) programStop();
+    active = true;
+    based = false;
+    ended = false;
+    eyes = -1;
+    frames = 0;
+    played = 0;
+    late = 0;
+    lost = 0;
+    stale = 0;
+    overflow = 0;
+    rebased = 0;
+    slackMinUs = INT32_MAX;
+    slackMaxUs = INT32_MIN;
+    systemState.setMode(RunModeSerial);  // Before the first frame is queued, core 1 drops frames in any other mode
+    Serial.printf("Stream started\n");
+  }
+
+  void end(const char* why) {
+    active = false;
+    systemState.setMode(RunModeDMX);
+    Serial.printf("Stream ended (%s): frames:%lu played:%lu lost:%lu stale:%lu late:%lu overflow:%lu rebase:%lu slack:%ld-%ldus\n", why,
+                  (unsigned long)frames, (unsigned long)played, (unsigned long)lost, (unsigned long)stale, (unsigned long)late,
+                  (unsigned long)overflow, (unsigned long)rebased, (long)(frames ? slackMinUs : 0), (long)(frames ? slackMaxUs : 0));
+  }
+
+  // Core 0, a TelemetryStream record from the console
+  void receive(const uint8_t* rec, uint32_t len) {
+    StreamRecord r;
+    if (len != sizeof(r)) return;
+    memcpy(&r, rec, len);
+    if (!active) {
+      if (r.flags & StreamEnd) return;
+      begin();
+    }
+    lastRecordMs = millis();
+    uint32_t now = time_us_32();
+    if (based) {
+      int16_t step = r.seq - lastSeq;
+      if (step <= 0) {
+        stale++;
+        return;
+      }
+      lost += step - 1;
+    } else {
+      based = true;
+      hostBase = r.timeUs;
+      localBase = now + STREAM_LEAD_US;
+    }
+    lastSeq = r.seq;
+
+    uint32_t due = localBase + (r.timeUs - hostBase);
+    int32_t slack = due - now;
+    if (slack < 0 || slack > 2 * STREAM_LEAD_US) {
+      localBase += STREAM_LEAD_US - slack;  // Back to the middle of the buffer
+      due = now + STREAM_LEAD_US;
+      slack = STREAM_LEAD_US;
+      rebased++;
+    }
+    if (slack < slackMinUs) slackMinUs = slack;
+    if (slack > slackMaxUs) slackMaxUs = slack;
+
+    StreamSample* s = ring.claim();
+    if (s == NULL) {
+      overflow++;
+      return;
+    }
+    s->flags = r.flags;
+    s->eyes = r.eyes;
+    s->dueUs = due;
+    memcpy(s->level, r.level, sizeof(s->level));
+    ring.commit();
+    if (!(r.flags & StreamEnd)) frames++;
+  }
+
+  // Core 1, writes the targets of the newest frame that is due
+  void apply() {
+    StreamSample s;
+    bool run = systemState.getMode() == RunModeSerial;
+    while (ring.peek(s)) {
+      if (!run) {
+        ring.pop();  // Left over from a stream that ended
+        continue;
+      }
+      if (s.flags & StreamEnd) {
+        ring.pop();
+        ended = true;
+        return;
+      }
+      uint32_t now = time_us_32();
+      if ((int32_t)(now - s.dueUs) < 0) return;
+      if (now - s.dueUs > STREAM_LATE_US) late = late + 1;
+      for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+        ServoConfig& c = C1_config_R[i];
+        if (c.licensed) C1_run_R[i].settargetDeg(s.level[i] * (c.maxDeg - c.minDeg) / 65535 + c.minDeg);
+      }
+      if (s.flags & StreamEyes) eyes = s.eyes;
+      played = played + 1;
+      ring.pop();
+    }
+  }
+};
+
+StreamPlayer streamPlayer;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+
+// consoleRecord(), a TelemetryStream frame
+void streamReceive(const uint8_t* rec, uint32_t len) {
+#if RS5_STREAM
+  streamPlayer.receive(rec, len);
+#endif
+}
+
+// Core 1 loop1(), before setServoPositions()
+inline void streamApply() {
+#if RS5_STREAM
+  if (streamPlayer.ring.head == streamPlayer.ring.tail) return;
+  streamPlayer.apply();
+#endif
+}
+
+// Core 0 in RunModeSerial: ends the stream and returns the eye preset DMX
+// value, -1 while the stream hasn't set one
+int streamPoll() {
+#if RS5_STREAM
+  if (streamPlayer.ended) streamPlayer.end("end");
+  else if (millis() - streamPlayer.lastRecordMs > STREAM_TIMEOUT_MS) streamPlayer.end("timeout");
+  return streamPlayer.eyes;
+#else
+  return -1;
+#endif
+}
+
+// Frames arriving within the DMX packet age limit, for the status light
+bool streamLive() {
+#if RS5_STREAM
+  return millis() - streamPlayer.lastRecordMs < (unsigned long)systemState.getDMXPacketAgeLimit();
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,317 @@
+// ============================================================================
+// File: RS5Teach.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Teach-in, records a live DMX performance into the flash
+//              program region so the skull can replay it standalone
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Teach-in Recording
+//
+// A take needs a blank program region. A sector erase parks core 1 for about
+// 45ms, far too long for a live show, so the erase is its own step: console
+// 'K' erases the region one sector per loop() pass, and only while every
+// servo is asleep, so core 1 is parked with nothing to move. 'k' refuses to
+// start on a region that is not blank.
+//
+// Console 'k' starts a take: every DMX frame is sampled on core 0 right after
+// readDMX().
+// The tracks are the ones a program plays, the servo channels from the DMX
+// address and the eye preset channel. Frames are delta and run length coded
+// (ProgramFrames in RS5Program.h): a frame where nothing moved costs nothing,
+// one that did costs its time delta, a mask and a zigzag delta per changed
+// track, so a still skull records for free and a busy one takes a few bytes
+// per frame.
+//
+// Bytes go into a small ring of flash pages in RAM. Full pages are programmed
+// at most one per TEACH_WRITE_GAP_MS, so the motion core is never held for
+// more than one page program at a time, about 0.5ms. These stalls are the
+// cost a take puts on core 1, the stop report gives the longest and their
+// total. The first page carries the header,
+// which needs the final length and CRC, so it stays in RAM and is programmed
+// last when 'k' ends the take or the region is full. The take then loads as
+// a looping program, 'g' plays it.
+#ifndef RS5_TEACH
+#define RS5_TEACH 1
+#endif
+
+#define TEACH_PAGES         4    // RAM ring of flash pages, 1.1s of the busiest take
+#define TEACH_WRITE_GAP_MS  20   // Between page programs, one servo PWM period
+#define TEACH_FRAME_MAX     (5 + 1 + 2 * PROGRAM_TRACKS)  // Worst case bytes of one frame
+
+enum teachState {
+  TeachIdle = 0,
+  TeachErasing,   // Console 'K', not part of a take
+  TeachRecording
+};
+
+extern volatile uint8_t bufferDmx[];  // SkullMasterV2.ino
+
+#if RS5_TEACH
+
+//**********************************************************************************
+// Recorder, core 0 only
+class TeachRecorder {
+public:
+  uint8_t state;
+  uint32_t erased;       // Bytes of the region erased so far
+  uint8_t head[FLASH_PAGE_SIZE];  // Page 0, header and the first events
+  uint8_t ring[TEACH_PAGES][FLASH_PAGE_SIZE];
+  uint32_t size;         // Bytes of the image, header included
+  uint32_t flushed;      // Pages programmed, page 0 excepted
+  uint32_t crc;          // Running CRC-32 of the events
+  uint8_t last[PROGRAM_TRACKS];  // Levels as recorded so far
+  uint32_t lastCount;    // dmxFrameCount at the last sample
+  bool based;
+  uint32_t firstUs;      // dmxFrameUs of the first frame, program time 0
+  uint32_t lastMs;       // Program time of the last recorded frame
+  uint32_t lastWriteMs;
+  uint32_t frames;       // Frames recorded, unchanged ones excepted
+  uint32_t overrun;      // Frames dropped because the page ring was full
+  uint32_t writeMaxUs;   // Longest page program
+  uint32_t writeUs;      // All page programs of the take, core 1 parked
+  uint32_t eraseWaitMs;  // millis() the erase started waiting for the servos, 0 running
+
+public:
+  TeachRecorder() {
+    state = TeachIdle;
+    erased = 0;
+    size = 0;
+    flushed = 0;
+    crc = 0;
+    lastCount = 0;
+    based = false;
+    firstUs = 0;
+    lastMs = 0;
+    lastWriteMs = 0;
+    frames = 0;
+    overrun = 0;
+    writeMaxUs = 0;
+    writeUs = 0;
+    eraseWaitMs = 0;
+  }
+
+public:
+
+  // Erase the program region ahead of a take, one sector per poll()
+  void erase() {
+    programPlayer.loaded = false;  // Its flash is about to be erased
+    state = TeachErasing;
+    erased = 0;
+    eraseWaitMs = 0;
+  }
+
+  // Region blank, start sampling
+  void start() {
+    state = TeachRecording;
+    lastCount = dmxFrameCount;
+    memset(head, 0xFF, sizeof(head));
+    memset(ring, 0xFF, sizeof(ring));
+    memset(last, 0, sizeof(last));
+    size = sizeof(ProgramHeader);
+    flushed = 1;
+    crc = 0;
+    based = false;
+    lastMs = 0;
+    lastWriteMs = millis();
+    frames = 0;
+    overrun = 0;
+    writeMaxUs = 0;
+    writeUs = 0;
+  }
+
+  // No servo driven, a parked core 1 has nothing to move
+  bool servosAsleep() {
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (C1_config_R[i].licensed && C1_run_R[i].PwmEnabled) return false;
+    }
+    return true;
+  }
+
+  void put(uint8_t b) {
+    uint32_t page = size / FLASH_PAGE_SIZE;
+    if (page == 0) head[size] = b;
+    else ring[page % TEACH_PAGES][size % FLASH_PAGE_SIZE] = b;
+    size++;
+  }
+
+  void putVarint(uint32_t v) {
+    while (v >= 0x80) {
+      put((v & 0x7F) | 0x80);
+      v >>= 7;
+    }
+    put(v);
+  }
+
+  // Program page n of the image from the ring and free its slot
+  void program(uint32_t n) {
+    uint8_t* p = ring[n % TEACH_PAGES];
+    uint32_t t0 = time_us_32();
+    flashRegionProgram(FLASH_PROGRAM_OFFSET + n * FLASH_PAGE_SIZE, p, FLASH_PAGE_SIZE);
+    uint32_t us = time_us_32() - t0;
+    if (us > writeMaxUs) writeMaxUs = us;
+    writeUs += us;
+    memset(p, 0xFF, FLASH_PAGE_SIZE);
+  }
+
+  // Sample the newest DMX frame, false when the take is full
+  bool sample() {
+    uint32_t frameCount = dmxFrameCount;
+    if (frameCount == lastCount) return true;
+    lastCount = frameCount;
+    if (bufferDmx[0] != 0) return true;  // Not a dimmer frame
+
+    uint32_t at = dmxFrameUs;
+    if (!based) {
+      based = true;
+      firstUs = at;
+    }
+    uint32_t ms = (at - firstUs) / 1000;
+    if (ms >= PROGRAM_DURATION_MAX) return false;
+
+    uint8_t level[PROGRAM_TRACKS];
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) level[i] = bufferDmx[i + systemState.getDMXAddress()];
+    level[PROGRAM_TRACK_EYES] = bufferDmx[systemState.startDMXEyes + 1];
+    uint8_t mask = 0;
+    for (int k = 0; k < PROGRAM_TRACKS; k++) {
+      if (frames == 0 || level[k] != last[k]) mask |= 1 << k;
+    }
+    if (mask == 0) return true;  // Run of unchanged frames, the next delta spans it
+
+    if (size + TEACH_FRAME_MAX > FLASH_PROGRAM_SIZE) return false;
+    if ((size + TEACH_FRAME_MAX - 1) / FLASH_PAGE_SIZE >= flushed + TEACH_PAGES) {
+      overrun++;  // Skipped, the next frame carries the change
+      return true;
+    }
+    uint32_t from = size;
+    putVarint(ms - lastMs);
+    put(mask);
+    for (int k = 0; k < PROGRAM_TRACKS; k++) {
+      if (!(mask & (1 << k))) continue;
+      int d = level[k] - last[k];
+      putVarint(d < 0 ? (uint32_t)(-d - 1) * 2 + 1 : (uint32_t)d * 2);
+      last[k] = level[k];
+    }
+    // The frame can straddle page 0 and the ring
+    for (uint32_t i = from; i < size; i++) {
+      uint32_t page = i / FLASH_PAGE_SIZE;
+      uint8_t b = page == 0 ? head[i] : ring[page % TEACH_PAGES][i % FLASH_PAGE_SIZE];
+      crc = crc32Update(crc, &b, 1);
+    }
+    lastMs = ms;
+    frames++;
+    return true;
+  }
+
+  // Core 0, once per loop() pass
+  void poll() {
+    if (state == TeachErasing) {
+      if (!servosAsleep()) {
+        if (eraseWaitMs == 0) {
+          eraseWaitMs = millis();
+          Serial.printf("Teach-in erase waiting for the servos to sleep\n");
+        }
+        return;
+      }
+      eraseWaitMs = 0;
+      flashRegionErase(FLASH_PROGRAM_OFFSET + erased, FLASH_SECTOR_SIZE);
+      erased += FLASH_SECTOR_SIZE;
+      if (erased < FLASH_PROGRAM_SIZE) return;
+      state = TeachIdle;
+      Serial.printf("Teach-in region erased, 'k' records\n");
+      return;
+    }
+    if (state != TeachRecording) return;
+    if (!sample()) {
+      Serial.printf("Teach-in take is full\n");
+      stop();
+      return;
+    }
+    if (flushed < size / FLASH_PAGE_SIZE && millis() - lastWriteMs >= TEACH_WRITE_GAP_MS) {
+      program(flushed++);
+      lastWriteMs = millis();
+    }
+  }
+
+  // Write what is left and the header page, then load the take
+  void stop() {
+    if (state == TeachErasing) {
+      state = TeachIdle;
+      Serial.printf("Teach-in erase stopped at %lu of %lu sectors, no program in flash\n", (unsigned long)(erased / FLASH_SECTOR_SIZE),
+                    (unsigned long)(FLASH_PROGRAM_SIZE / FLASH_SECTOR_SIZE));
+      return;
+    }
+    state = TeachIdle;
+    if (frames == 0) {
+      Serial.printf("Teach-in stopped: no DMX frames\n");
+      return;
+    }
+    uint32_t pages = (size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+    while (flushed < pages) program(flushed++);
+    ProgramHeader h;
+    h.magic = PROGRAM_MAGIC;
+    h.version = PROGRAM_VERSION;
+    h.flags = ProgramLoop | ProgramFrames;
+    h.durationMs = lastMs + 1;  // The last frame is held until the loop point
+    h.length = size - sizeof(ProgramHeader);
+    h.crc = crc;
+    memcpy(head, &h, sizeof(h));
+    uint32_t t0 = time_us_32();
+    flashRegionProgram(FLASH_PROGRAM_OFFSET, head, FLASH_PAGE_SIZE);
+    writeUs += time_us_32() - t0;
+    uint32_t perMin = h.durationMs ? (uint32_t)((uint64_t)size * 60000 / h.durationMs) : 0;
+    Serial.printf("Teach-in stopped: frames:%lu bytes:%lu ms:%lu bytes/min:%lu pages:%lu overrun:%lu write max:%luus total:%luus\n",
+                  (unsigned long)frames, (unsigned long)size, (unsigned long)h.durationMs, (unsigned long)perMin,
+                  (unsigned long)pages, (unsigned long)overrun, (unsigned long)writeMaxUs, (unsigned long)writeUs);
+    if (!loadProgram()) Serial.printf("Teach-in take did not verify\n");
+  }
+};
+
+TeachRecorder teachRecorder;
+
+#endif
+
+//**********************************************************************************
+// Hooks for the sketch, empty when compiled out
+inline void teachPoll() {
+#if RS5_TEACH
+  if (teachRecorder.state == TeachIdle) return;
+  PROFILE_STAGE(ProfileTeach);
+  teachRecorder.poll();
+#endif
+}
+
+// Console 'k'
+void teachToggle() {
+#if RS5_TEACH
+  if (teachRecorder.state != TeachIdle) teachRecorder.stop();
+  else if (systemState.getMode() == RunModeProgram) Serial.printf("Stop the program before teach-in\n");
+  else if (!flashRegionAvailable(FLASH_PROGRAM_OFFSET, FLASH_PROGRAM_SIZE)) Serial.printf("No flash program region, check the FS size\n");
+  else if (!flashRegionBlank(FLASH_PROGRAM_OFFSET, FLASH_PROGRAM_SIZE)) Serial.printf("Teach-in region not blank, erase it with 'K' first\n");
+  else {
+    teachRecorder.start();
+    Serial.printf("Teach-in recording\n");
+  }
+#else
+  Serial.printf("Teach-in compiled out (RS5_TEACH 0)\n");
+#endif
+}
+
+// Console 'K', erases the program in flash
+void teachErase() {
+#if RS5_TEACH
+  if (teachRecorder.state != TeachIdle) Serial.printf("Teach-in busy, 'k' stops it\n");
+  else if (systemState.getMode() == RunModeProgram) Serial.printf("Stop the program before erasing it\n");
+  else if (!flashRegionAvailable(FLASH_PROGRAM_OFFSET, FLASH_PROGRAM_SIZE)) Serial.printf("No flash program region, check the FS size\n");
+  else {
+    teachRecorder.erase();
+    Serial.printf("Teach-in erasing the program region\n");
+  }
+#else
+  Serial.printf("Teach-in compiled out (RS5_TEACH 0)\n");
+#endif
+}
@@ -0,0 +1,408 @@
+// ============================================================================
+// File: RS5Telemetry.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Binary telemetry, fixed size records queued in lock free rings
+//              and sent COBS framed over USB by a low priority task
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <hardware/timer.h>
+
+//**********************************************************************************
+// Telemetry Records
+//
+// Telemetry records are 20 bytes, little endian, framed on the wire as
+//   0x00, COBS(record), 0x00
+// The leading zero closes any text the console printed in between, so a
+// decoder drops at most one frame after mixed output. extras/tools/
+// telemetry_decode.py decodes the stream.
+#define TELEMETRY_RING_SIZE     64     // Records per producer ring, power of two
+#define TELEMETRY_DRAIN_PERIOD  5      // ms between drain passes
+#define TELEMETRY_TRACE_DRAIN_PERIOD 1 // ms between drain passes while deferred trace is on, see RS5Trace.h
+#define TELEMETRY_STATS_PERIOD  1000   // ms between TelemetryStats records
+#define TELEMETRY_LOOP_PERIOD   1000   // ms between TelemetryLoop records
+#define TELEMETRY_SERVO_PERIOD  10     // ms between TelemetryServo records per servo
+
+enum telemetryType {
+  TelemetryServo = 1,        // id servo, v: pos, target, velocity (x10), duty, flags
+  TelemetryServoConfig = 2,  // id servo, v: minDeg, maxDeg, maxVel, maxAcc, maxDec, freq
+  TelemetryDMX = 3,          // id start code, v: address, 4 watched channels, frame age ms
+  TelemetryLoop = 4,         // id profileStage, v: count, min, avg, p99, max us, 0
+  TelemetryStats = 5,        // v: dropped core 0, dropped core 1, sent, dropped drain task, trace dropped core 0, core 1
+  TelemetryTrace = 6,        // Deferred log record, see RS5Trace.h
+  TelemetryCapture = 7,      // DMX capture frame, see RS5Capture.h
+  TelemetryCommand = 8,      // Command reply, see RS5Command.h
+  TelemetryStream = 9,       // Host target frame, inbound only, see RS5Stream.h
+  TelemetryRecorder = 10     // Flight recorder dump, its own frames without a type, see RS5Recorder.h
+};
+
+// Bits in TelemetryServo v[4]
+#define TELEMETRY_SERVO_ACTIVE   0x01
+#define TELEMETRY_SERVO_PWM      0x02
+
+// Record types turned on at runtime
+#define TELEMETRY_MASK(t)        (1u << (t))
+
+struct TelemetryRecord {
+  uint8_t type;
+  uint8_t id;
+  uint16_t seq;     // Per ring sequence, gaps show dropped records
+  uint32_t timeUs;  // time_us_32() when recorded
+  int16_t v[6];
+};
+
+static_assert(sizeof(TelemetryRecord) == 20, "TelemetryRecord must stay 20 bytes, the decoder depends on it");
+
+static inline int16_t telemetryClamp(int32_t v) {
+  return v > 32767 ? 32767 : (v < -32768 ? -32768 : v);
+}
+
+//**********************************************************************************
+// Record Ring, single producer / single consumer
+//
+// Only the producer writes head and only the drain task writes tail, so no
+// lock is needed. A full ring drops the record and counts it, the producer
+// never waits. N must be a power of two.
+template<typename T, uint32_t N>
+class RecordRing {
+public:
+  T record[N];
+  volatile uint32_t head;  // Next slot to write, producer only
+  volatile uint32_t tail;  // Next slot to read, consumer only
+  uint16_t seq;
+  uint32_t dropped;
+
+public:
+  RecordRing() {
+    head = 0;
+    tail = 0;
+    seq = 0;
+    dropped = 0;
+  }
+
+public:
+
+  // Producer side, returns the slot to fill or NULL if full
+  T* claim() {
+    if (head - tail >= N) {
+      dropped++;
+      seq++;
+      return NULL;
+    }
+    T* r = &record[head & (N - 1)];
+    r->seq = seq++;
+    return r;
+  }
+
+  void commit() {
+    __sync_synchronize();  // Record visible before the new head
+    head = head + 1;
+  }
+
+  // Consumer side
+  bool peek(T& r) {
+    uint32_t t = tail;
+    if (t == head) return false;
+    __sync_synchronize();
+    r = record[t & (N - 1)];
+    return true;
+  }
+
+  void pop() {
+    __sync_synchronize();  // Slot copied before it is handed back
+    tail = tail + 1;
+  }
+};
+
+typedef RecordRing<TelemetryRecord, TELEMETRY_RING_SIZE> TelemetryRing;
+
+//**********************************************************************************
+// COBS encode len bytes into out (len + len / 254 + 1 bytes), returns bytes written
+uint32_t cobsEncode(const uint8_t* in, uint32_t len, uint8_t* out) {
+  uint32_t code = 0;  // Index of the current code byte
+  uint32_t o = 1;
+  uint8_t run = 1;
+  for (uint32_t i = 0; i < len; i++) {
+    if (in[i] == 0) {
+      out[code] = run;
+      code = o++;
+      run = 1;
+    } else {
+      out[o++] = in[i];
+      if (++run == 0xFF) {
+        out[code] = run;
+        code = o++;
+        run = 1;
+      }
+    }
+  }
+  out[code] = run;
+  return o;
+}
+
+// COBS decode len bytes (no zeros) into out, returns bytes written or -1 if malformed
+int cobsDecode(const uint8_t* in, uint32_t len, uint8_t* out, uint32_t outMax) {
+  uint32_t o = 0;
+  uint32_t i = 0;
+  while (i < len) {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > len) return -1;
+    for (uint8_t k = 1; k < code; k++) {
+      if (o >= outMax) return -1;
+      out[o++] = in[i++];
+    }
+    if (code != 0xFF && i < len) {
+      if (o >= outMax) return -1;
+      out[o++] = 0;
+    }
+  }
+  return o;
+}
+
+#define TELEMETRY_RECORD_MAX  64  // Largest record of any type, RecorderSample (RS5Recorder.h)
+#define TELEMETRY_FRAME_MAX   (TELEMETRY_RECORD_MAX + TELEMETRY_RECORD_MAX / 254 + 3)
+
+bool traceNextFrame();    // RS5Trace.h
+uint32_t traceDropped(int core);  // RS5Trace.h
+bool captureNextFrame();  // RS5Capture.h
+bool commandNextFrame();  // RS5Command.h
+bool recorderNextFrame(); // RS5Recorder.h
+
+//**********************************************************************************
+// Inbound Frames
+//
+// The host sends records with the same 0x00, COBS(record), 0x00 framing.
+// Console characters outside a frame pass through, so single key commands
+// and frames share the port. A frame too long for any record is dropped up
+// to the next zero.
+class FrameReader {
+public:
+  uint8_t buf[TELEMETRY_FRAME_MAX];
+  uint8_t len;
+  uint8_t state;                          // 0 console, 1 in a frame, 2 dropping
+  uint8_t record[TELEMETRY_RECORD_MAX];
+  uint8_t recordLen;                      // Set by feed() when a frame completes
+  uint32_t bad;
+
+public:
+  FrameReader() {
+    len = 0;
+    state = 0;
+    recordLen = 0;
+    bad = 0;
+  }
+
+public:
+
+  // Returns false for a console character. A completed frame is decoded into
+  // record/recordLen, recordLen is 0 for every other byte.
+  bool feed(uint8_t c) {
+    recordLen = 0;
+    if (c == 0) {
+      if (state == 1 && len > 0) {
+        int n = cobsDecode(buf, len, record, sizeof(record));
+        if (n > 0) recordLen = n;
+        else bad++;
+        state = 0;
+      } else if (state == 2) {
+        state = 0;  // End of the dropped frame
+      } else {
+        state = 1;  // A zero opens a frame, repeated zeros are empty frames
+      }
+      len = 0;
+      return true;
+    }
+    if (state == 0) return false;
+    if (state == 1) {
+      if (len < sizeof(buf)) {
+        buf[len++] = c;
+      } else {
+        bad++;
+        state = 2;
+      }
+    }
+    return true;
+  }
+};
+
+//**********************************************************************************
+// Telemetry
+//
+// Every ring has exactly one producer: loop() and loop1() write the ring of
+// their core, the drain task writes its own periodic ring. The task runs
+// below loop() on core 0, so sharing ring[0] with it would let loop() claim
+// a slot in the middle of the task's claim and commit.
+#define TELEMETRY_RING_TASK  2
+
+class Telemetry {
+public:
+  TelemetryRing ring[3];       // One per core, indexed by get_core_num(), and the drain task's
+  volatile uint32_t enabled;   // TELEMETRY_MASK() of record types to produce
+  uint32_t sent;
+  uint32_t lastStats;
+  uint32_t lastLoop;
+  uint32_t lastServo[NUM_LIC_SERVOS];
+  TaskHandle_t task;
+  uint8_t frame[TELEMETRY_FRAME_MAX];
+  uint8_t frameLen;            // Bytes of frame still to send
+  uint8_t framePos;
+
+public:
+  Telemetry() {
+    enabled = 0;
+    sent = 0;
+    lastStats = 0;
+    lastLoop = 0;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) lastServo[i] = 0;
+    task = NULL;
+    frameLen = 0;
+    framePos = 0;
+  }
+
+public:
+
+  bool on(uint8_t type) {
+    return enabled & TELEMETRY_MASK(type);
+  }
+
+  void enable(uint8_t type, bool state) {
+    if (state) enabled |= TELEMETRY_MASK(type);
+    else enabled &= ~TELEMETRY_MASK(type);
+  }
+
+  // Queue a record from the calling core, cheap enough for the run loops
+  bool record(uint8_t type, uint8_t id, int16_t v0 = 0, int16_t v1 = 0, int16_t v2 = 0, int16_t v3 = 0, int16_t v4 = 0, int16_t v5 = 0) {
+    return recordTo(get_core_num() & 1, type, id, v0, v1, v2, v3, v4, v5);
+  }
+
+  // Queue a record into ring q, whose only producer must be the caller
+  bool recordTo(int q, uint8_t type, uint8_t id, int16_t v0 = 0, int16_t v1 = 0, int16_t v2 = 0, int16_t v3 = 0, int16_t v4 = 0, int16_t v5 = 0) {
+    if (!on(type)) return false;
+    TelemetryRecord* r = ring[q].claim();
+    if (r == NULL) return false;
+    r->type = type;
+    r->id = id;
+    r->timeUs = time_us_32();
+    r->v[0] = v0;
+    r->v[1] = v1;
+    r->v[2] = v2;
+    r->v[3] = v3;
+    r->v[4] = v4;
+    r->v[5] = v5;
+    ring[q].commit();
+    return true;
+  }
+
+  // Rate limit a per servo record, call before building it
+  bool servoDue(int i) {
+    if (!on(TelemetryServo)) return false;
+    uint32_t now = millis();
+    if (now - lastServo[i] < TELEMETRY_SERVO_PERIOD) return false;
+    lastServo[i] = now;
+    return true;
+  }
+
+  // Send as much queued data as the USB buffer takes without blocking
+  void drain() {
+    while (true) {
+      if (frameLen == 0 && !nextFrame()) return;
+      int room = Serial.availableForWrite();
+      if (room <= 0) return;
+      int n = frameLen - framePos;
+      if (n > room) n = room;
+      Serial.write(frame + framePos, n);
+      framePos += n;
+      if (framePos >= frameLen) {
+        frameLen = 0;
+        sent++;
+      }
+    }
+  }
+
+  // Encode the oldest record of any ring, then deferred log records, DMX capture, command replies and the recorder dump, into frame
+  bool nextFrame() {
+    TelemetryRecord r;
+    for (int c = 0; c < 3; c++) {
+      if (ring[c].peek(r)) {
+        ring[c].pop();
+        setFrame(&r, sizeof(r));
+        return true;
+      }
+    }
+    return traceNextFrame() || captureNextFrame() || commandNextFrame() || recorderNextFrame();
+  }
+
+  void setFrame(const void* rec, uint32_t len) {
+    frame[0] = 0;
+    frameLen = cobsEncode((const uint8_t*)rec, len, frame + 1) + 1;
+    frame[frameLen++] = 0;
+    framePos = 0;
+  }
+};
+
+Telemetry telemetry;
+
+// Debug levels that used to print from the run loops stream telemetry records
+// instead, set at boot and again when the debug level changes
+void telemetryFollowLog() {
+  telemetry.enable(TelemetryDMX, Log<LogDMX>::enabled());
+  telemetry.enable(TelemetryServoConfig, Log<LogServo>::enabled());
+  telemetry.enable(TelemetryServo, Log<LogServo>::enabled() || Log<LogModel>::enabled());
+  telemetry.enable(TelemetryStats, Log<LogDMX>::enabled() || Log<LogServo>::enabled() || Log<LogModel>::enabled());
+}
+
+//**********************************************************************************
+// Periodic records, called from the drain task so the run loops pay nothing.
+// They go to the task's own ring, never to the ring of the core it runs on
+void telemetryPeriodic() {
+  uint32_t now = millis();
+
+#if RS5_PROFILER
+  if (telemetry.on(TelemetryLoop) && now - telemetry.lastLoop >= TELEMETRY_LOOP_PERIOD) {
+    telemetry.lastLoop = now;
+    for (int i = 0; i < ProfileStageCount; i++) {
+      ProfileStat& s = profileStat[i];
+      telemetry.recordTo(TELEMETRY_RING_TASK, TelemetryLoop, i, telemetryClamp(s.count), telemetryClamp(s.count ? s.minUs : 0), telemetryClamp(s.avgUs()),
+                       telemetryClamp(s.percentileUs(99)), telemetryClamp(s.maxUs));
+    }
+  }
+#endif
+
+  if (telemetry.on(TelemetryStats) && now - telemetry.lastStats >= TELEMETRY_STATS_PERIOD) {
+    telemetry.lastStats = now;
+    telemetry.recordTo(TELEMETRY_RING_TASK, TelemetryStats, 0, telemetryClamp(telemetry.ring[0].dropped), telemetryClamp(telemetry.ring[1].dropped),
+                       telemetryClamp(telemetry.sent), telemetryClamp(telemetry.ring[TELEMETRY_RING_TASK].dropped), telemetryClamp(traceDropped(0)),
+                       telemetryClamp(traceDropped(1)));
+  }
+}
+
+//**********************************************************************************
+// Drain Task, lowest priority above idle on core 0 so it only runs while
+// loop() sleeps and never touches core 1 timing
+
+// ms to the next drain pass, shorter while a full rate trace fills core 1's ring
+uint32_t telemetryDrainPeriod() {
+  return telemetry.on(TelemetryTrace) ? TELEMETRY_TRACE_DRAIN_PERIOD : TELEMETRY_DRAIN_PERIOD;
+}
+
+void telemetryTask(void* param) {
+  (void)param;
+  while (true) {
+    if (telemetry.enabled) {
+      telemetryPeriodic();
+      telemetry.drain();
+    }
+    vTaskDelay(pdMS_TO_TICKS(telemetryDrainPeriod()));
+  }
+}
+
+void startTelemetry() {
+  if (telemetry.task != NULL) return;
+  // Pinned from creation, so it never starts on core 1
+  xTaskCreateAffinitySet(telemetryTask, "telemetry", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, 1 << 0, &telemetry.task);
+}
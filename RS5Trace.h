@@ -0,0 +1,167 @@
+// ============================================================================
+// File: RS5Trace.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Deferred format logger, stores a format string hash, a time
+//              stamp and raw arguments; the host rebuilds the text
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+//**********************************************************************************
+// Deferred Trace
+//
+//   TRACE(LogModel, "servo %d pos %f vel %f", i, DL[i].getPosition(), DL[i].getVelocity());
+//
+// Nothing is formatted on the RP2040. The format string is hashed at compile
+// time (FNV-1a) and only the hash, time_us_32() and up to TRACE_MAX_ARGS raw
+// 32 bit arguments are queued. The telemetry task sends the records as
+// TelemetryTrace frames. extras/tools/trace_strings.py extracts every TRACE()
+// format from the sources into a side table that telemetry_decode.py uses to
+// print the text.
+//
+// Arguments are stored as 32 bits. Use %d/%i/%u/%x/%c for integers and
+// %f/%e/%g for floats, the host picks the type from the conversion.
+//
+// loop1() runs unpaced, about 16k control ticks a second, and a TRACE_AXIS()
+// in the tick traces every axis on every pass. Core 1's ring holds what that
+// produces between two drain passes, which come every
+// TELEMETRY_TRACE_DRAIN_PERIOD while tracing is on: 16k x 6 axes is about
+// 100 records a millisecond, so TRACE_RING_SIZE_CORE1 leaves room for a
+// drain held off by loop() for several milliseconds. Full rate is more than
+// USB full speed carries for long, so a long run still drops, and a full
+// ring drops and counts; the counts go out in TelemetryStats. Building with
+// TRACE_AXIS_PERIOD_US limits each axis to one record per period instead.
+#define TRACE_RING_SIZE        64    // Records on core 0, power of two
+#define TRACE_RING_SIZE_CORE1  512   // Records on core 1, power of two
+#define TRACE_MAX_ARGS         5
+#ifndef TRACE_AXIS_PERIOD_US
+#define TRACE_AXIS_PERIOD_US   0     // us between TRACE_AXIS() records per axis, 0 every tick
+#endif
+
+struct TraceRecord {
+  uint8_t type;    // TelemetryTrace, so the decoder can tell it from a TelemetryRecord
+  uint8_t nargs;
+  uint16_t seq;
+  uint32_t timeUs;
+  uint32_t id;     // traceHash() of the format string
+  uint32_t arg[TRACE_MAX_ARGS];
+};
+
+static_assert(sizeof(TraceRecord) <= TELEMETRY_RECORD_MAX, "TraceRecord must fit a telemetry frame");
+
+// Categories traced at runtime, LOG_BIT() of logCategory
+uint32_t traceMask = 0;
+
+RecordRing<TraceRecord, TRACE_RING_SIZE> traceRing0;        // Core 0
+RecordRing<TraceRecord, TRACE_RING_SIZE_CORE1> traceRing1;  // Core 1, the control tick
+
+#if TRACE_AXIS_PERIOD_US
+uint32_t traceAxisUs[NUM_LIC_SERVOS];  // Last trace per axis, core 1
+
+// Rate limit for TRACE_AXIS(), false while tracing is off
+inline bool traceAxisDue(int i) {
+  if (!telemetry.on(TelemetryTrace)) return false;
+  uint32_t now = time_us_32();
+  if (now - traceAxisUs[i] < TRACE_AXIS_PERIOD_US) return false;
+  traceAxisUs[i] = now;
+  return true;
+}
+#endif
+
+// FNV-1a, 32 bit. Must match trace_strings.py.
+constexpr uint32_t traceHash(const char* s, uint32_t h = 2166136261u) {
+  return *s ? traceHash(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+
+//**********************************************************************************
+// Argument packing, raw 32 bit values. int32_t is long on the RP2040 toolchain,
+// so both int and long are listed.
+inline uint32_t traceArg(int v) {
+  return (uint32_t)v;
+}
+inline uint32_t traceArg(unsigned int v) {
+  return v;
+}
+inline uint32_t traceArg(long v) {
+  return (uint32_t)v;
+}
+inline uint32_t traceArg(unsigned long v) {
+  return (uint32_t)v;
+}
+inline uint32_t traceArg(float v) {
+  uint32_t u;
+  memcpy(&u, &v, sizeof(u));
+  return u;
+}
+inline uint32_t traceArg(double v) {
+  return traceArg((float)v);
+}
+
+template<typename Ring, typename... Args>
+void traceWriteTo(Ring& q, uint32_t id, Args... args) {
+  TraceRecord* r = q.claim();
+  if (r == NULL) return;
+  r->type = TelemetryTrace;
+  r->nargs = sizeof...(Args);
+  r->timeUs = time_us_32();
+  r->id = id;
+  uint32_t packed[sizeof...(Args) + 1] = { traceArg(args)..., 0 };
+  for (uint32_t a = 0; a < sizeof...(Args); a++) r->arg[a] = packed[a];
+  q.commit();
+}
+
+template<typename... Args>
+void traceWrite(uint32_t id, Args... args) {
+  static_assert(sizeof...(Args) <= TRACE_MAX_ARGS, "TRACE() takes at most TRACE_MAX_ARGS arguments");
+  if (get_core_num() & 1) traceWriteTo(traceRing1, id, args...);
+  else traceWriteTo(traceRing0, id, args...);
+}
+
+// Compiled only where Log<category, LogDebug> is, so RS5_LOG_MASK strips traces too
+#define TRACE(category, fmt, ...) \
+  do { \
+    if constexpr (Log<category, LogDebug>::compiled) { \
+      if ((traceMask & LOG_BIT(category)) && telemetry.on(TelemetryTrace)) { \
+        constexpr uint32_t traceId = traceHash(fmt); \
+        traceWrite(traceId, ##__VA_ARGS__); \
+      } \
+    } \
+  } while (0)
+
+// TRACE() of axis i in the control tick, every pass unless TRACE_AXIS_PERIOD_US is set
+#if TRACE_AXIS_PERIOD_US
+#define TRACE_AXIS(category, i, fmt, ...) \
+  do { \
+    if (traceAxisDue(i)) TRACE(category, fmt, ##__VA_ARGS__); \
+  } while (0)
+#else
+#define TRACE_AXIS(category, i, fmt, ...) TRACE(category, fmt, ##__VA_ARGS__)
+#endif
+
+//**********************************************************************************
+// Turn tracing of the given categories on or off, 0 turns it off
+void traceEnable(uint32_t mask) {
+  traceMask = mask;
+  telemetry.enable(TelemetryTrace, mask != 0);
+}
+
+// Records lost to a full ring on that core, for TelemetryStats
+uint32_t traceDropped(int core) {
+  return core ? traceRing1.dropped : traceRing0.dropped;
+}
+
+// Drain side, called by Telemetry::nextFrame() once the telemetry rings are empty
+bool traceNextFrame() {
+  TraceRecord r;
+  if (traceRing0.peek(r)) {
+    traceRing0.pop();
+  } else if (traceRing1.peek(r)) {
+    traceRing1.pop();
+  } else {
+    return false;
+  }
+  telemetry.setFrame(&r, sizeof(r) - (TRACE_MAX_ARGS - r.nargs) * sizeof(uint32_t));
+  return true;
+}
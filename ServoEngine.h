@@ -706,6 +706,19 @@ public:
   }
 
 protected:
+  /**
+     * @brief  position += velocity * time while decelerating into the target, moving at least one float step
+     * @note  a few ulps from the target the step can round away to nothing, the limiter then never arrives
+     * @retval None
+     */
+  void stepTowardTarget() {
+    float moved = position + velocity * time;
+    if (moved == position && velocity != 0 && (velocity > 0) == (target > position)) {
+      moved = nextafterf(position, target);
+    }
+    position = moved;
+  }
+
   /**
      * @brief  this is where the actual code is
      * @retval (float) position
@@ -764,7 +777,7 @@ protected:
           accel = -sq(velocity) / 2.0 / (target - (position));
           accel = constrain(accel, -decelLimit * maxStoppingDecel, decelLimit * maxStoppingDecel);
           velocity += accel * time;
-          position += velocity * time;
+          stepTowardTarget();
         }
       } else if (velocity != 0 && target != position && (velocity > 0) != (target - position > 0)) {  // if going wrong way, decel
         accel = ((target - position > 0) ? decelLimit : -decelLimit);
@@ -25,6 +25,28 @@
 #include "RS5DualCore.h"        // multicore data sharing setup
 #include "RS5hardware.h"        // Hardware Setup
 #include "RS5DMX.h"             // Pirate
+#include "RS5Log.h"             // Category logging
+#include "RS5Pixels.h"          // Dirty tracked pixel frame
+#include "RS5Flash.h"           // Flash map and CRC
+#include "RS5Eyes.h"            // Compiled eye preset table
+#include "RS5Flicker.h"         // Procedural flicker generator
+#include "RS5Compositor.h"      // Eye crossfades
+#include "RS5Profiler.h"        // Hot path profiler
+#include "RS5Telemetry.h"       // Binary telemetry stream
+#include "RS5Trace.h"           // Deferred format logger
+#include "RS5Latency.h"         // DMX to servo latency tracer
+#include "RS5Recorder.h"        // Motion flight recorder
+#include "RS5Load.h"            // Per core load meters
+#include "RS5Memory.h"          // Stack, heap and static RAM monitor
+#include "RS5Capture.h"         // DMX show capture and replay
+#include "RS5Program.h"         // Choreography playback from flash
+#include "RS5Teach.h"           // Teach-in recording into flash
+#include "RS5Store.h"           // Config store and saved positions in flash
+#include "RS5Governor.h"        // Servo current sense and motion governor
+#include "RS5Stall.h"           // Stall and overload detection
+#include "RS5Command.h"         // Binary command protocol for live tuning
+#include "RS5Stream.h"          // USB streaming control, RunModeSerial
+#include "RS5Boot.h"            // Boot sequencer and timeline
 
 
 // GLOBAL
@@ -38,7 +60,7 @@
 // Setup Status Lights and System Status Neopixel
 int statusLightTimer = 0;  // Last status change CPU cycles
 int status = 0;            // satus holds the current status of Core1
-int statusFrameFreq = 10;
+int statusFrameFreq = 10;  // Minimum milliseconds between pixel frames (refresh rate cap)
 int statusFrameLast = 0;
 Adafruit_NeoPixel pixels(NUMPIXELS, PIN, NEO_RGB + NEO_KHZ800);
 //**********************************************************************************
@@ -47,7 +69,6 @@ Adafruit_NeoPixel pixels(NUMPIXELS, PIN, NEO_RGB + NEO_KHZ800);
 // define state machine instances for servos
 RP2040_PWM* servoInstance[NUM_SERVO_PINS];
 const float servoStartDC = 7.5f;  // Starting Dutycyle as a precentage
-int servoStartDelay = 250;        // Delay in milliseconds bettween starting each servo
 //**********************************************************************************
 
 //**********************************************************************************
@@ -61,6 +82,17 @@ volatile uint8_t bufferDmx[DMXINPUT_BUFFER_SIZE(1, 512)];  // Define DMX duffer
 Derivs_Limiter DL[NUM_SERVO_PINS];
 //**********************************************************************************
 
+//**********************************************************************************
+// Binary records from the host on the console port
+FrameReader consoleFrames;
+//**********************************************************************************
+
+//**********************************************************************************
+// Eye preset DMX value from the program, -1 until its eye track starts
+int programEyes = -1;
+int streamEyes = -1;
+//**********************************************************************************
+
 // ********************************************************************************
 // initilize and start  Core zero with Servo Maintenance and DMX Recieve system
 // ********************************************************************************
@@ -70,6 +102,7 @@ Derivs_Limiter DL[NUM_SERVO_PINS];
 //**********************************************************************************
 // Core 0 Setup
 void setup() {
+  bootMark(BootSetup);
 
   // Setup Semaphores for Data Handling bettween cores
   systemStateLock = xSemaphoreCreateMutex();
@@ -79,19 +112,20 @@ void setup() {
 
   systemState.setBootLevel(0);  // Set Bot Mode to Core Zero Setup
 
-  if (systemState.getDebugLevel() > DebugLevelNone) {
+  // Setup Serial Port, always open for the serial console
+  Serial.begin(115200);
+  logSetDebugLevel(systemState.getDebugLevel());  // Runtime log mask, below the RS5Log.h compile time ceiling
 
-    // Setup Serial Port
-    Serial.begin(115200);
-    while (!Serial) {
-      //delay(1);
-    }
+  if (Log<LogBoot>::enabled()) {
+
+    bootWaitConsole();
 
 
     Serial.printf("Rose&Swan\nPirate Servo DMX Version %s\n", SOFTWARE_VERSION);
     Serial.printf("Copyright Rose&Swan 2022(c) All Rights Reserved\n");
     Serial.printf("Core Zero: Starting, Debug Level:%d\n", systemState.getDebugLevel());
   }
+  bootMark(BootConsole);
 
   // Set Dip Swtich and Run Mode Dip Switches to inout, and pulled up to 3.3V
   pinMode(DMX_BIT_1_PIN, INPUT_PULLUP);
@@ -112,17 +146,31 @@ void setup() {
 
 
   ReadDmxDipSwitches();
+  storeLoad();          // Newest config image from flash, before anything reads it
+  bootMark(BootConfig);
+  currentStart();  // Sampling before the first servo starts, the boot sequence paces on it
+  systemState.setBootLevel(1);  // Core 1 starts the servos while this core sets up the rest
+
+  compileEyePresets();  // Build the DMX to eye preset lookup, including user presets from flash
+  Log<LogBoot>::printf("Core Zero: Eye Presets:%d (User:%d)\n", eyePresets.count, eyePresets.userCount);
+  loadProgram();  // Validate the choreography in flash for RunModeProgram
   dmxInput.begin(DMX_PIN, 1, 512);  // Start DMX Reciever
-  dmxInput.read_async(bufferDmx);   // Start Asynchronus Read
+  dmxInput.read_async(bufferDmx, dmxFrameArrived);  // Start Asynchronus Read, stamp each frame for the latency tracer
+  bootMark(BootDMX);
 
   // Start DMX Reciver1 & Dip Switch Pins
 
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core Zero: DMX Start Addr:%d\n", systemState.getDMXAddress());
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core Zero: Initializing Asynchronus DMX Reciever on Pin %d, DMX Range %d-%d, Buffer Size: %d\n", DMX_PIN, 1, 1, 512, DMXINPUT_BUFFER_SIZE(1, 512));
+  telemetryFollowLog();  // Debug levels that used to print from the run loops stream telemetry records instead
+  startTelemetry();
+  memoryWatchTask("loop", xTaskGetCurrentTaskHandle());  // setup() and loop() share the core 0 task
+  memoryWatchTask("telemetry", telemetry.task);
+
+  Log<LogBoot>::printf("Core Zero: DMX Start Addr:%d\n", systemState.getDMXAddress());
+  Log<LogBoot>::printf("Core Zero: Initializing Asynchronus DMX Reciever on Pin %d, DMX Range %d-%d, Buffer Size: %d\n", DMX_PIN, 1, 1, 512, DMXINPUT_BUFFER_SIZE(1, 512));
 
   // Get Run Mode INformation from Dip Switches
   //getRunMode(); Removed for Pirate Show
-  systemState.setBootLevel(1);  // Set Boot Mode to Core One Setup
+  bootMark(BootCore0);
 }
 // End Core 0 setup
 //**********************************************************************************
@@ -140,37 +188,80 @@ void loop() {
     delay(1);
   }
 
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core Zero: Entering Run Mode\n");
+  Log<LogBoot>::printf("Core Zero: Entering Run Mode\n");
 
   systemState.setBootLevel(4);  // Let Core One Start Loop()
 
 
   while (true) {
+    loadPass();
+    {
+      PROFILE_STAGE(ProfileLoop0);  // Time the pass, not the delay below
+
+      //******************************************************************************
+      // Check Dip Switches and see if Run Mode has changed
+      //getRunMode(); Removed for Custom Pirate version
+      //******************************************************************************
+
+      //******************************************************************************
+      // Check Dip Switches and see if Run Mode has changed
+      ReadDmxDipSwitches();
+
+      //******************************************************************************
+
+      //******************************************************************************
+      // Write replayed DMX frames that are due into the frame buffer
+      replayPoll();
+      //******************************************************************************
+
+      //******************************************************************************
+      // Read DMX and set Target Servo Postions
+      if (systemState.getMode() == RunModeDMX) {
+        if (checkDMX()) {  // Check for DMX signal and set status
+          readDMX();
+          updateStatusLight(STATUS_DMX_RECIEVE);  // Update Status LED Settings
+        } else {
+          updateStatusLight(STATUS_DMX_BAD);  // Update Status LED Settings
+        }
+      }
+      capturePoll();  // Queue the new frame when DMX capture is on
+      teachPoll();    // Record the new frame when teach-in is on
+      //******************************************************************************
+
+      //******************************************************************************
+      // Play the choreography from flash and set Target Servo Postions
+      programAutostart();
+      if (systemState.getMode() == RunModeProgram) {
+        programEyes = programPoll();
+        updateStatusLight(STATUS_PROGRAM);
+      }
+      //******************************************************************************
 
-    //******************************************************************************
-    // Check Dip Switches and see if Run Mode has changed
-    //getRunMode(); Removed for Custom Pirate version
-    //******************************************************************************
-
-    //******************************************************************************
-    // Check Dip Switches and see if Run Mode has changed
-    ReadDmxDipSwitches();
-
-    //******************************************************************************
-
-    //******************************************************************************
-    // Read DMX and set Target Servo Postions
-    if (systemState.getMode() == RunModeDMX) {
-      if (checkDMX()) {  // Check for DMX signal and set status
-        readDMX();
-        updateStatusLight(STATUS_DMX_RECIEVE);  // Update Status LED Settings
-      } else {
-        updateStatusLight(STATUS_DMX_BAD);  // Update Status LED Settings
+      //******************************************************************************
+      // Stream from the host over USB, core one applies the targets
+      if (systemState.getMode() == RunModeSerial) {
+        streamEyes = streamPoll();
+        updateStatusLight(streamLive() ? STATUS_USB_RECIEVE : STATUS_USB_BAD);
       }
+      //******************************************************************************
+
+      //******************************************************************************
+      // Render Eyes, Status and Servo LEDs and hand the frame to core one
+      renderPixels();
+      //******************************************************************************
+
+      //******************************************************************************
+      // Serial console commands
+      readConsole();
+      //******************************************************************************
+
+      //******************************************************************************
+      // Stack and heap margins, warns over serial
+      memoryCheck();
+      //******************************************************************************
     }
-    //******************************************************************************
 
-    delay(1);
+    loadDelay(1);  // delay(1), booked as idle time for the load meter
   }
 }
 // End Core Zero Loop
@@ -189,6 +280,7 @@ void setup1() {
   while (systemState.getBootLevel() != 1) {
     delay(1);
   }
+  bootMark(BootCore1);
 
   //***************************************************
   // Default Servo Settings;
@@ -243,55 +335,66 @@ void setup1() {
   C1_run_R[EYE_SERVO_POS].setcurentPos(EYE_START_POS);
   C1_run_R[EYE_SERVO_POS].settargetPos(EYE_START_POS);
 
+  // Tuning saved in the config store replaces the defaults
+  storeApplyServos();
 
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Starting Setup\n");
+
+  Log<LogBoot>::printf("Core One: Starting Setup\n");
 
 
   //*********************************************************
   // setup status LED and turn on during setup
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: initializing NeoPixel and Built in LED.\n");
+  Log<LogBoot>::printf("Core One: initializing NeoPixel and Built in LED.\n");
 
   // INITIALIZE NeoPixel strip object (REQUIRED)
   pixels.begin();  // INITIALIZE NeoPixel strip object (REQUIRED)
 
   // Tell the ouside workd that boot in progress
   statusLed(STATUS_BOOT);
+  publishPixelFrame();
   sendPixelFrame();
-  delay(1000);
+  bootMark(BootPixels);
 
-  // setup servo Movoment Profiles
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Initilizing Motility Engine for each servo:\n");
+  // setup servo Movoment Profiles, starting at the rest pose
+  Log<LogBoot>::printf("Core One: Initilizing Motility Engine for each servo:\n");
   for (int i = 0; i < NUM_LIC_SERVOS; i++) {
-    if (systemState.getDebugLevel() > DebugLevelModel) Serial.printf("Core One: Starting Motility Model for Servo %d, %s\n", C1_config_R[i].servoNum, C1_config_R[i].servoUserName);
+    Log<LogBoot, LogDebug>::printf("Core One: Starting Motility Model for Servo %d, %s\n", C1_config_R[i].servoNum, C1_config_R[i].servoUserName);
     if (!C1_config_R[i].smooth) {
       DL[i] = Derivs_Limiter(C1_config_R[i].maxVel, INFINITY, INFINITY, C1_config_R[i].ServoStartDeg, C1_config_R[i].ServoStartDeg, 0, false, false, -INFINITY, INFINITY);
     } else {
       DL[i] = Derivs_Limiter(C1_config_R[i].maxVel, C1_config_R[i].maxAcc, C1_config_R[i].maxDec, C1_config_R[i].ServoStartDeg, C1_config_R[i].ServoStartDeg, 0, false, false, -INFINITY, INFINITY);
     }
+    C1_run_R[i].setcurentPos(C1_config_R[i].ServoStartDeg);  // First pulse where the engine starts, loop1() ramps to the target
   }
+  bootMark(BootMotion);
 
   // Setup Servo State Machines
   statusLed(STARTING_SERVOS);
+  publishPixelFrame();
   sendPixelFrame();
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Initilizing State Machines and Starting Servo's in an orderly Manner:\n");
+  Log<LogBoot>::printf("Core One: Initilizing State Machines and Starting Servo's in an orderly Manner:\n");
   for (int i = 0; i < NUM_LIC_SERVOS; i++) {
-    if (C1_config_R[i].licensed) servoStatusLed(i, SERVO_STATUS_STARTUP);
-    if (!C1_config_R[i].licensed) servoStatusLed(i, SERVO_STATUS_NOTLICENSED);
-    delay(servoStartDelay / 2);
-    if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Starting Servo %d, %s, on Pin %d, state machine %d, start position %d degrees\n", C1_config_R[i].servoNum, C1_config_R[i].servoUserName, hardware[i].getServoPin(), hardware[i].getStateMachine(), C1_config_R[i].ServoStartDeg);
-
-    if (C1_config_R[i].licensed) servoInstance[i] = new RP2040_PWM(hardware[i].getServoPin(), C1_config_R[i].freq, getDutyCycle(i));  // initilize state machine for each servo
-
-    if (C1_config_R[i].licensed) servoInstance[i]->setPWM();
-    if (C1_config_R[i].licensed) servoInstance[i]->disablePWM();
-    statusLed(STARTING_SERVOS);
+    if (!C1_config_R[i].licensed) {
+      servoStatusLed(i, SERVO_STATUS_NOTLICENSED);
+      continue;
+    }
+    servoStatusLed(i, SERVO_STATUS_STARTUP);
+    publishPixelFrame();
     sendPixelFrame();
+    Log<LogBoot>::printf("Core One: Starting Servo %d, %s, on Pin %d, state machine %d, start position %.0f degrees\n", C1_config_R[i].servoNum, C1_config_R[i].servoUserName, hardware[i].getServoPin(), hardware[i].getStateMachine(), C1_config_R[i].ServoStartDeg);
 
-    if (C1_config_R[i].licensed) servoStatusLed(i, SERVO_START_SUCSESS);
-    delay(servoStartDelay / 2);
+    servoInstance[i] = new RP2040_PWM(hardware[i].getServoPin(), C1_config_R[i].freq, getDutyCycle(i));  // initilize state machine for each servo
+    servoInstance[i]->setPWM();  // Holds the rest pose from here on
+    C1_run_R[i].PwmEnabled = true;
+    C1_run_R[i].setlastMove(millis());  // Sleep timer counts from the first pulse
+    bootSettle(i);                      // Next servo once this one's inrush is over
+
+    servoStatusLed(i, SERVO_START_SUCSESS);
   }
+  bootMark(BootServos);
+  publishPixelFrame();  // Core zero takes over rendering once it enters run mode
 
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Finsihed Setting Up:\n");
+  Log<LogBoot>::printf("Core One: Finsihed Setting Up:\n");
 
   systemState.setBootLevel(3);  // Turn over boot control to Core zero loop()
 }
@@ -311,40 +414,43 @@ void loop1() {
   while (systemState.getBootLevel() != 4) {
     delay(1);
   }
-  if (systemState.getDebugLevel() > DebugLevelNone) Serial.printf("Core One: Entering Run Mode\n");  // Debug Ourput - Core 1 begin
+  memoryWatchTask("loop1", xTaskGetCurrentTaskHandle());  // Core 0 is done registering by now
+  bootMark(BootRun);
+  Log<LogBoot>::printf("Core One: Entering Run Mode\n");  // Debug Ourput - Core 1 begin
+  if (Log<LogBoot>::enabled()) bootReport();
   systemState.setBootLevel(5);                                                                       // Let Core One Start Loop()
 
   // Main Run Loop.
   while (true) {  // Main Loop
+    PROFILE_STAGE(ProfileLoop1);
+    loadPass();
+    commandApply();  // Host settings changes, between two control ticks
+    streamApply();   // Due stream frames into the targets, drops leftovers outside RunModeSerial
+    governorApply();  // Limits scaled to the current budget
+    stallApply();     // Jammed axes found by the current and rested
 
     //********************************************************************
     // DMX Run Mode
 
     if (systemState.getMode() == RunModeDMX) {
+      setServoPositions();  // Calculate next Servo Positions and write to GPIO Pins
+      sendPixelFrame();     // Output the latest frame rendered by core zero
+    }
+    //********************************************************************
 
-      // ******************************************************************************************
-      // POP SHOW EYE Managemnet Code
-
-      if (bufferDmx[systemState.startDMXEyes + 1] < 10) {
-        // Determine Eye color mode
-
-          setEyeColor();  // set eye color to mode to RGB Mode
-      } else {            // Set Preset FLicker Modes
-
-        for (int i = 0; i < (sizeof(eyeLight) / sizeof(eyeLight[0])); i++) {
-
-          if (bufferDmx[systemState.startDMXEyes + 1] >= eyeLight[i].getdmxStart() && bufferDmx[systemState.startDMXEyes + 1] <= eyeLight[i].getdmxEnd()) {
+    //********************************************************************
+    // Program Run Mode, core zero plays the program into the targets
+    if (systemState.getMode() == RunModeProgram) {
+      setServoPositions();  // Calculate next Servo Positions and write to GPIO Pins
+      sendPixelFrame();     // Output the latest frame rendered by core zero
+    }
+    //********************************************************************
 
-            eyeColorProfile = i;
-            break;
-          }
-        }
-        flickerEyes(eyeColorProfile);
-      }
-      //********************************************************************************************
-      
+    //********************************************************************
+    // Serial Run Mode, streamApply() set the targets
+    if (systemState.getMode() == RunModeSerial) {
       setServoPositions();  // Calculate next Servo Positions and write to GPIO Pins
-      sendPixelFrame();
+      sendPixelFrame();     // Output the latest frame rendered by core zero
     }
     //********************************************************************
 
@@ -352,25 +458,18 @@ void loop1() {
     // DEMO MODE
     if (systemState.getMode() == RunModeDemo) {
       sweepPos();
-      flickerEyes(REDFIREEYES);
-      updateStatusLight(STATUS_DEMO_MODE);
       setServoPositions();  // Calculate next Servo Positions and write to GPIO Pins
-      sendPixelFrame();
+      sendPixelFrame();     // Output the latest frame rendered by core zero
     }
     //********************************************************************
-
-
-    //********************************************************************
-    //  Montior Servo's and set Servo LED
-
-    servoMonitor();
-
-    //********************************************************************
     // Run DEBUG output if needed
 
-    if (systemState.getDebugLevel() == DebugLevelServoFull) servoTracker();
-    if (systemState.getDebugLevel() == DebugLevelServo) servoTrackerLite();
-    if (systemState.getDebugLevel() == DebugLevelVoltCurrent) CheckCurrent();
+    {
+      PROFILE_STAGE(ProfileDebugHooks);
+      if (Log<LogServo, LogDebug>::enabled()) servoTracker();
+      else if (Log<LogServo>::enabled()) servoTrackerLite();
+      if (Log<LogPower>::enabled()) CheckCurrent();
+    }
     //********************************************************************
   }
 }
@@ -401,7 +500,7 @@ float getDutyCycle(int i) {
   int PWMUpper = floatMap(C1_config_R[i].maxDeg, C1_config_R[i].servoMinDeg, C1_config_R[i].servoMaxDeg, C1_config_R[i].minPWM, C1_config_R[i].maxPWM);
 
   // Calculate DutyCycle
-  float dutyCycle = 100 * (floatMap(C1_run_R[i].getcurentPos(), C1_config_R[i].minDeg, C1_config_R[i].maxDeg, PWMLower / ((1 / C1_config_R[i].freq) * 1000000), PWMUpper / ((1 / C1_config_R[i].freq) * 1000000)));
+  float dutyCycle = 100 * (floatMap(C1_run_R[i].getcurentDeg(), C1_config_R[i].minDeg, C1_config_R[i].maxDeg, PWMLower / ((1 / C1_config_R[i].freq) * 1000000), PWMUpper / ((1 / C1_config_R[i].freq) * 1000000)));
 
   return dutyCycle;
 }
@@ -411,16 +510,22 @@ float getDutyCycle(int i) {
 //**********************************************************************************
 // Read DMX Values and put in Servo Profiles
 bool readDMX() {
+  PROFILE_STAGE(ProfileReadDMX);
 
   if (bufferDmx[0] != 0) {
-    if (systemState.getDebugLevel() == DebugLevelDMX) Serial.printf("Bad DMX Frame:%d (Position One not equal to zero)\n", bufferDmx[0]);
+    if constexpr (Log<LogDMX>::compiled) telemetryDMX();  // Bad frame, id carries the start code
+    TRACE(LogDMX, "dmx bad start code %u", bufferDmx[0]);
     return false;
   }
 
+  latencyFrameRead();
+
   // Read DMX data and update target postion in run data.
   for (int i = 0; i < NUM_LIC_SERVOS; i++) {
     if (C1_config_R[i].licensed) {
+      int before = C1_run_R[i].gettargetPos();
       if (bufferDmx[0] == 0) C1_run_R[i].settargetPos(floatMap(bufferDmx[i + systemState.getDMXAddress()], 0, 255, C1_config_R[i].minDeg, C1_config_R[i].maxDeg));
+      if (C1_run_R[i].gettargetPos() != before) latencyTagTarget(i);  // Time this cue through to the PWM write
     }
   }
 
@@ -435,16 +540,7 @@ bool readDMX() {
   //if (bufferDmx[0] == 0) eyeDmx.setgreen(bufferDmx[systemState.getDMXAddress() + NUM_LIC_SERVOS + 3]);
   //if (bufferDmx[0] == 0) eyeDmx.setblue(bufferDmx[systemState.getDMXAddress() + NUM_LIC_SERVOS + 4]);
 
-  if (systemState.getDebugLevel() == DebugLevelDMX) {
-    Serial.printf("DMX Address:%d  ", systemState.getDMXAddress());
-    Serial.printf("Frame Status:%d  ", bufferDmx[0]);
-    for (int i = 0; i <= 512; i++) {
-      if (i == systemState.getDMXAddress() || i == systemState.getDMXAddress() + 1 || i == systemState.startDMXEyes || i == systemState.startDMXEyes + 1) {
-        Serial.printf("%u:%u  ", i, bufferDmx[i]);
-      }
-    }
-  }
-  if (systemState.getDebugLevel() == DebugLevelDMX) Serial.printf("\n");
+  if constexpr (Log<LogDMX>::compiled) telemetryDMX();
   return true;
 }
 // ********************************************************************************
@@ -453,27 +549,25 @@ bool readDMX() {
 //**********************************************************************************
 // Calculate Servo Postions
 void setServoPositions() {
+  PROFILE_STAGE(ProfileServoPositions);
+  RecorderSample* rec = recorderBeginTick();  // NULL unless this tick is sampled
 
   for (int i = 0; i < NUM_LIC_SERVOS; i++) {
 
     // Check that Servo is Licensed
     if (!C1_config_R[i].licensed) continue;
-    if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf("===Servo %d, good License, ", i);
 
     // Set new Target Postion for Servo
-    DL[i].setTarget(C1_run_R[i].gettargetPos());
-
-    if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf("Target:%d, ", int(C1_run_R[i].gettargetPos()));
+    DL[i].setTarget(C1_run_R[i].gettargetDeg());
 
     // Calculaite New Servo Postions.
     DL[i].calc();
-    C1_run_R[i].setcurentPos(DL[i].getPosition());
-
-    if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf("Position:%d, ", int(C1_run_R[i].getcurentPos()));
+    C1_run_R[i].setcurentDeg(DL[i].getPosition());
+    TRACE_AXIS(LogModel, i, "servo %d pos %f vel %f acc %f target %f", i, DL[i].getPosition(), DL[i].getVelocity(), DL[i].getAcceleration(), DL[i].getTarget());
 
     //check to see if servo is quite
 
-    if (C1_run_R[i].isServoActive()) {
+    if (C1_run_R[i].isServoActive() && !stallResting(i)) {
       if (!C1_run_R[i].PwmEnabled) {
         C1_run_R[i].PwmEnabled = true;
       }
@@ -482,19 +576,23 @@ void setServoPositions() {
         C1_run_R[i].PwmEnabled = false;
       }
     }
-    if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf("Status %d ", int(C1_run_R[i].isServoActive()));
-
 
     // Update previos postion and calculate new servo postion
     C1_run_R[i].setpreviousPos(C1_run_R[i].getcurentPos());
-    if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf(". Duty Cycle %d", int(getDutyCycle(i)));
-    if (C1_run_R[i].PwmEnabled) {
-      servoInstance[i]->setPWM(hardware[i].pin, C1_config_R[i].freq, getDutyCycle(i));
-    } else {
-      servoInstance[i]->setPWM(hardware[i].pin, C1_config_R[i].freq, 0);
+    float duty = C1_run_R[i].PwmEnabled ? getDutyCycle(i) : 0;
+    servoInstance[i]->setPWM(hardware[i].pin, C1_config_R[i].freq, duty);
+    latencyPwmWritten(i);
+
+    if (rec) {
+      recorderStore(rec, i, DL[i].getTarget(), DL[i].getPosition(), DL[i].getVelocity(), DL[i].getAcceleration(), duty);
+      if (DL[i].getPosition() < C1_config_R[i].minDeg - 0.5f || DL[i].getPosition() > C1_config_R[i].maxDeg + 0.5f) recorderFire(RecorderTriggerLimit);
+    }
+
+    if constexpr (Log<LogModel>::compiled || Log<LogServo>::compiled) {
+      if (telemetry.servoDue(i)) telemetryServo(i);
     }
   }
-  if (systemState.getDebugLevel() == DebugLevelModel) Serial.printf("\n");
+  if (rec) recorderEndTick();
   return;
 }
 // ********************************************************************************
@@ -505,9 +603,10 @@ void setServoPositions() {
 
 
 bool checkDMX() {
-  if (millis() > dmxInput.latest_packet_timestamp() + systemState.getDMXPacketAgeLimit()) {
+  if (millis() > dmxLastPacketMs() + systemState.getDMXPacketAgeLimit()) {
+    if (status == STATUS_DMX_RECIEVE) recorderFire(RecorderTriggerDMXLoss);  // Signal just dropped
     status = STATUS_DMX_BAD;
-    if (systemState.getDebugLevel() == DebugLevelDMX) Serial.printf("No DMX:%d\n", status);
+    Log<LogDMX, LogWarn>::printf("No DMX:%d\n", status);
     return false;
   }
   status = STATUS_DMX_RECIEVE;  // Set Status to DMX Normal
@@ -520,11 +619,9 @@ bool checkDMX() {
 // Status Light
 void updateStatusLight(int i) {
   if (statusLight[i].timeToUpdateStatus()) {
-    if (pixels.getPixelColor(STATUSPIXEL) != 0) {
-      Serial.printf("Status !0 Pixel:%d\n",pixels.getPixelColor(STATUSPIXEL));
+    if (pixelFrame.getPixel(STATUSPIXEL) != 0) {
       statusLed(STATUS_OFF);
     } else {
-      Serial.printf("Status = 0 Pixel:%d\n",pixels.getPixelColor(STATUSPIXEL));
       statusLed(i);
     }
   }
@@ -537,7 +634,7 @@ void updateStatusLight(int i) {
 // update status light
 void statusLed(int i) {
   //pixels.clear(); // Set all pixel colors to 'off'
-  pixels.setPixelColor(STATUSPIXEL, pixels.Color(statusLight[i].green, statusLight[i].red, statusLight[i].blue));
+  pixelFrame.setPixel(STATUSPIXEL, pixels.Color(statusLight[i].green, statusLight[i].red, statusLight[i].blue));
 }
 // ********************************************************************************
 
@@ -546,7 +643,7 @@ void statusLed(int i) {
 // update status light
 void servoStatusLed(int x, int i) {
   int s = x + 1;  // offset SPI NeoPixel address by one to account for status light. Servo 0 starts at 1
-  pixels.setPixelColor(s, pixels.Color(statusLight[i].green, statusLight[i].red, statusLight[i].blue));
+  pixelFrame.setPixel(s, pixels.Color(statusLight[i].green, statusLight[i].red, statusLight[i].blue));
 }
 // ********************************************************************************
 
@@ -554,12 +651,17 @@ void servoStatusLed(int x, int i) {
 //**********************************************************************************
 // Servo Status Monitor
 void servoMonitor() {
+  PROFILE_STAGE(ProfileServoMonitor);
   for (int i = 0; i < NUM_LIC_SERVOS; i++) {
     if (!C1_config_R[i].isServoLicensed()) {
       servoStatusLed(i, SERVO_STATUS_NOTLICENSED);
       continue;
     }
-    if (!C1_run_R[i].isServoActive()) {
+    if (stallResting(i)) {
+      servoStatusLed(i, SERVO_STATUS_STALLED);
+      continue;
+    }
+    if (!C1_run_R[i].PwmEnabled) {  // Set by core one, avoids isServoActive() touching lastMove from this core
       servoStatusLed(i, SERVO_STATUS_PWM_DISABLED);
       continue;
     }
@@ -574,27 +676,49 @@ void servoMonitor() {
 
 
 //**********************************************************************************
-// Debug Routine
+// Debug Routine, configuration of the debug servo (positions come from setServoPositions())
 void servoTrackerLite() {
 
   if (systemState.timeToSample()) {
-    int i = systemState.getDebugServo();
-    Serial.printf("CurrentPostion:%d, TargetPosition:%d, MaxDegrees:%d, MinDegrees:%d\n", int(C1_run_R[i].getcurentPos()), int(C1_run_R[i].gettargetPos()), int(C1_config_R[i].maxDeg), int(C1_config_R[i].minDeg));
+    telemetryServoConfig(systemState.getDebugServo());
   }
 }
 // ********************************************************************************
 
 
 //**********************************************************************************
-// Debug Routine
+// Debug Routine, configuration of every licensed servo
 void servoTracker() {
 
   if (systemState.timeToSample()) {
-    int i = systemState.getDebugServo();
-    Serial.printf("CurrentPostion:%d, TargetPosition:%d, MaxDegrees:%d, MaxVelocity:%d, MaxAccelration:%d, MaxDeceleration:%d, Smoothing Mode:%d, MaxPWM:%d, MinPWM:%d, Frequnecy:%d\n",
-                  i, C1_run_R[i].getservoNum(), int(C1_run_R[i].getcurentPos()), int(C1_run_R[i].gettargetPos()), int(C1_config_R[i].maxDeg), int(C1_config_R[i].maxVel), int(C1_config_R[i].maxAcc), int(C1_config_R[i].maxDec), C1_config_R[i].smooth, int(C1_config_R[i].maxPWM), int(C1_config_R[i].minPWM), int(C1_config_R[i].freq));
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (C1_config_R[i].licensed) telemetryServoConfig(i);
+    }
   }
 }
+
+//**********************************************************************************
+// Telemetry records, built here because they need sketch functions and data
+void telemetryServo(int i) {
+  uint8_t flags = 0;
+  if (C1_run_R[i].isServoActive()) flags |= TELEMETRY_SERVO_ACTIVE;
+  if (C1_run_R[i].PwmEnabled) flags |= TELEMETRY_SERVO_PWM;
+  telemetry.record(TelemetryServo, i, telemetryClamp(DL[i].getPosition() * 10), telemetryClamp(C1_run_R[i].gettargetDeg() * 10),
+                   telemetryClamp(DL[i].getVelocity() * 10), telemetryClamp(getDutyCycle(i)), flags);
+}
+
+void telemetryServoConfig(int i) {
+  telemetry.record(TelemetryServoConfig, i, telemetryClamp(C1_config_R[i].minDeg), telemetryClamp(C1_config_R[i].maxDeg), telemetryClamp(C1_config_R[i].maxVel),
+                   telemetryClamp(C1_config_R[i].maxAcc), telemetryClamp(C1_config_R[i].maxDec), telemetryClamp(C1_config_R[i].freq));
+}
+
+void telemetryDMX() {
+  if (!telemetry.on(TelemetryDMX)) return;
+  int a = systemState.getDMXAddress();
+  int e = systemState.startDMXEyes;
+  telemetry.record(TelemetryDMX, bufferDmx[0], a, bufferDmx[a], bufferDmx[a + 1], bufferDmx[e], bufferDmx[e + 1],
+                   telemetryClamp(millis() - dmxLastPacketMs()));
+}
 // ********************************************************************************
 
 
@@ -605,7 +729,7 @@ void randPos() {
     int i = random(0, 4);
     C1_run_R[i].settargetPos(random(C1_config_R[i].minDeg, C1_config_R[i].maxDeg));
     if (random(0, 100) > 90) {
-      pixels.setPixelColor(EYESPIXEL, random(150, 255), 24, 0);
+      pixelFrame.setPixel(EYESPIXEL, pixels.Color(random(150, 255), 24, 0));
     }
   }
 }
@@ -642,6 +766,7 @@ void getRunMode() {
 //**********************************************************************************
 // Read dip Switches and check Run Mode.
 void ReadDmxDipSwitches() {
+  PROFILE_STAGE(ProfileDipSwitches);
 
   //**********************************************************************************
   // Read dip Switches and and set run mode
@@ -678,7 +803,7 @@ void ReadDmxDipSwitches() {
 void CheckCurrent() {
   if (systemState.timeToSample()) {
     //systemState.setServoVoltage(map(analogRead(28),0,1023,SERVO_VOLT_LOW,SERVO_VOLT_HIGH));
-    systemState.setServoCurrent(map(analogRead(29), 0, 1023, SERVO_CURRENT_LOW, SERVO_CURRENT_HIGH));
+    systemState.setServoCurrent(currentNow());
     Serial.printf("Low:0,Current:%d,high:50\n", systemState.getServoCurrent());
   }
 }
@@ -703,52 +828,313 @@ void sweepPos() {
 // ********************************************************************************
 
 //**************************************************************************
-// Flicker Eyes
-void flickerEyes(int i) {
-  if (millis() > lastEyeFlicker) {                                         // check if fliker delay has passed
-    lastEyeFlicker = random(0, eyeLight[i].getflickerDelay()) + millis();  // Set new Flicker time
+// Flicker Eyes, render preset i at time now
+void flickerEyes(int i, uint32_t now, EyeOutput& out) {
+  if (i < 0 || i >= eyePresets.count) {
+    out = { { 0, 0, 0 }, 0 };
+    return;
+  }
 
-    int colorSelect = random(0, eyeLight[i].getflickerColorTime() + eyeLight[i].getflickerColorTime() + eyeLight[i].getblackColorTime());
+  // Smooth procedural flicker, the DMX brightness becomes the pixel level so the colour is never rescaled
+  eyeFlicker.render(eyePresets.preset[i], now, out.rgb);
+  out.level = bufferDmx[systemState.startDMXEyes];
 
-    if (colorSelect <= eyeLight[i].getbaseColorTime()) {
-      pixels.setPixelColor(EYESPIXEL, ((eyeLight[i].getbaseColor() >> 16) & 0xFF), ((eyeLight[i].getbaseColor() >> 8) & 0xFF), ((eyeLight[i].getbaseColor() & 0xFF)));
-    }
-    if (colorSelect <= eyeLight[i].getflickerColorTime() + eyeLight[i].getflickerColorTime() && colorSelect > eyeLight[i].getbaseColorTime() + 1) {
-      pixels.setPixelColor(EYESPIXEL, ((eyeLight[i].getflickerColor() >> 16) & 0xFF), ((eyeLight[i].getflickerColor() >> 8) & 0xFF), ((eyeLight[i].getflickerColor() & 0xFF)));
-    }
-    if (colorSelect > eyeLight[i].getflickerColorTime() + eyeLight[i].getflickerColorTime() + eyeLight[i].getblackColorTime() && colorSelect > eyeLight[i].getflickerColorTime() + eyeLight[i].getflickerColorTime() + 1) {
-      pixels.setPixelColor(EYESPIXEL, ((eyeLight[i].getblackColor() >> 16) & 0xFF), ((eyeLight[i].getblackColor() >> 8) & 0xFF), ((eyeLight[i].getblackColor() & 0xFF)));
-    }
+  Log<LogPixel>::printf(" flicker Mode Pixel:%d Brightness:%d M:%d Eye DMX Value:%d,%d Mode:%d Noise:%d Intensity:%d\n", EYESPIXEL, out.level, i, bufferDmx[systemState.startDMXEyes], bufferDmx[systemState.startDMXEyes + 1], eyeColorProfile, eyeFlicker.noise, eyeFlicker.intensity);
+}
+
+//*************************************************
+// Set Eye Color in RGB Mode
+void setEyeColor(EyeOutput& out) {
+
+  out.rgb[0] = (eyeDmx.getred() * eyeDmx.getbrightness()) / 255;
+  out.rgb[1] = (eyeDmx.getgreen() * eyeDmx.getbrightness()) / 255;
+  out.rgb[2] = (eyeDmx.getblue() * eyeDmx.getbrightness()) / 255;
+  out.level = 255;
 
-    pixels.setBrightness(bufferDmx[systemState.startDMXEyes]);
+  Log<LogPixel>::printf(" RGB Mode Pixel:%d Brightness:%d R:%d G:%d B:%d \n", EYESPIXEL, 255, out.rgb[0], out.rgb[1], out.rgb[2]);
+}
+
+//*************************************************
+// Render one eye effect, a preset index or EYE_EFFECT_RGB
+void renderEyeEffect(int effect, uint32_t now, EyeOutput& out) {
+  if (effect == EYE_EFFECT_RGB) {
+    setEyeColor(out);
+  } else if (effect == EYE_EFFECT_SNAPSHOT) {
+    out = eyeCompositor.snapshot;
+  } else {
+    flickerEyes(effect, now, out);
   }
-  if (systemState.getDebugLevel() == DebugLevelPixel) Serial.printf(" flicker Mode Pixel:%d Brightness:%d M:%d Eye DMX Value:%d,%d Mode:%d\n", EYESPIXEL, 255, i, bufferDmx[EYEDMX_BOTNAYBAY], bufferDmx[EYEDMX_BOTNAYBAY + 1], eyeColorProfile);
 }
 
 //*************************************************
-// Set Eye Color in 
-void setEyeColor() {
+// Composite the eyes and write the eye pixel, once per pixel frame
+void renderEyes(int effect) {
+  if (millis() > lastEyeFlicker + statusFrameFreq) {
+    PROFILE_STAGE(ProfileRenderEyes);
+    lastEyeFlicker = millis();
+    uint32_t now = lastEyeFlicker;
+
+    eyeCompositor.select(effect, now);
+    uint16_t a = eyeCompositor.mix(now);
+
+    EyeOutput out;
+    renderEyeEffect(eyeCompositor.current, now, out);
+    if (a < 256) {
+      EyeOutput in = out;
+      EyeOutput old;
+      renderEyeEffect(eyeCompositor.previous, now, old);
+      EyeCompositor::blend(old, in, a, out);
+    }
+    eyeCompositor.last = out;
 
-  if (millis() > eyeDmx.lastUpdate + eyeDmx.updateRate) {
+    pixelFrame.setPixel(EYESPIXEL, pixels.Color(out.rgb[0], out.rgb[1], out.rgb[2]));
+    pixelFrame.setLevel(EYESPIXEL, out.level);
+  }
+}
 
-    eyeDmx.lastUpdate = millis();
 
-    uint16_t r = (eyeDmx.getred() * eyeDmx.getbrightness()) / 255;
-    uint16_t g = (eyeDmx.getgreen() * eyeDmx.getbrightness()) / 255;
-    uint16_t b = (eyeDmx.getblue() * eyeDmx.getbrightness()) / 255;
+// ********************************************************************************
+// Render all LED effects into the pixel frame (Core 0)
+void renderPixels() {
+
+  //********************************************************************
+  // DMX Run Mode
+  if (systemState.getMode() == RunModeDMX) {
 
-    if (systemState.getDebugLevel() == DebugLevelPixel) Serial.printf(" RGB Mode Pixel:%d Brightness:%d R:%d G:%d B:%d \n", EYESPIXEL, 255, r, g, b);
+    // ******************************************************************************************
+    // POP SHOW EYE Managemnet Code
 
-    pixels.setPixelColor(EYESPIXEL, r, g, b);
+    uint8_t preset = eyePresets.lookup(bufferDmx[systemState.startDMXEyes + 1]);  // Determine Eye color mode
+
+    if (preset == EYE_LUT_RGB) {
+      renderEyes(EYE_EFFECT_RGB);  // set eye color to mode to RGB Mode
+    } else {                       // Set Preset FLicker Modes
+      if (preset != EYE_LUT_HOLD) eyeColorProfile = preset;
+      renderEyes(eyeColorProfile);
+    }
+    //********************************************************************************************
   }
+
+  //********************************************************************
+  // Program and Serial Run Modes, the eye track holds a DMX preset value
+  if (systemState.getMode() == RunModeProgram || systemState.getMode() == RunModeSerial) {
+    int eyes = systemState.getMode() == RunModeProgram ? programEyes : streamEyes;
+    uint8_t preset = eyes < 0 ? EYE_LUT_HOLD : eyePresets.lookup(eyes);
+    if (preset == EYE_LUT_RGB) {
+      renderEyes(EYE_EFFECT_RGB);
+    } else {
+      if (preset != EYE_LUT_HOLD) eyeColorProfile = preset;
+      renderEyes(eyeColorProfile);
+    }
+  }
+
+  //********************************************************************
+  // DEMO MODE
+  if (systemState.getMode() == RunModeDemo) {
+    renderEyes(REDFIREEYES);
+    updateStatusLight(STATUS_DEMO_MODE);
+  }
+
+  //********************************************************************
+  //  Montior Servo's and set Servo LED
+  servoMonitor();
+
+  //********************************************************************
+  //  Optional load display, green idle through red saturated
+  if (loadStatusPixel) {
+    uint16_t s = loadSaturation();
+    uint8_t level = s >= 500 ? 255 : (s * 255) / 500;        // Red rises to full by 50%
+    uint8_t fall = s <= 500 ? 255 : ((1000 - s) * 255) / 500;  // Green falls away above 50%
+    pixelFrame.setPixel(STATUSPIXEL, pixels.Color(fall, level, 0));  // Green first, as statusLed()
+  }
+
+  publishPixelFrame();
 }
+// ********************************************************************************
 
 
 // ********************************************************************************
-// Send a Frame of Pixel Data
+// Hand the render frame to the output core
+void publishPixelFrame() {
+  pixelExchange.publish(pixelFrame);
+}
+// ********************************************************************************
+
+
+// ********************************************************************************
+// Send a Frame of Pixel Data, only when the frame changed and no faster than statusFrameFreq (Core 1)
 void sendPixelFrame() {
+  PROFILE_STAGE(ProfilePixelFrame);
+  pixelExchange.collect(outputFrame);
+  if (!outputFrame.isDirty()) return;
   if (millis() > statusFrameLast + statusFrameFreq) {
     statusFrameLast = millis();
-    pixels.show();
+    outputFrame.flush(pixels);
   }
 }
+
+
+// ********************************************************************************
+// Serial Console, single character commands read on core 0
+//   p - dump profiler      r - reset profiler      t - telemetry on/off
+//   d - deferred trace on/off   l - DMX latency
+//   f - freeze recorder         w - write recorder a - arm recorder
+//   c - CPU load                C - load on status pixel
+//   m - memory report           x - DMX capture on/off g - program play/stop
+//   k - teach-in start/stop     K - erase for teach-in S - save config
+//   Z - clear config            P - save position      R - recall position
+//   b - boot timeline           i - current and governor
+//   j - stall detector          ? - help
+// Zero delimited COBS frames are binary records from the host (RS5Telemetry.h):
+// DMX replay (RS5Capture.h), tuning commands (RS5Command.h) and streamed targets (RS5Stream.h)
+void readConsole() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (consoleFrames.feed(c)) {
+      if (consoleFrames.recordLen) consoleRecord(consoleFrames.record, consoleFrames.recordLen);
+      continue;
+    }
+    switch (c) {
+      case 'p':
+        profilerDump();
+        break;
+      case 'r':
+        profilerReset();
+        latencyReset();
+        Serial.printf("Profiler reset\n");
+        break;
+      case 'l':
+        latencyDump();
+        break;
+      case 'f':
+        recorderFire(RecorderTriggerSerial);
+        break;
+      case 'w':
+        recorderDump();
+        break;
+      case 'a':
+        recorderArm();
+        break;
+      case 'c':
+        loadDump();
+        break;
+      case 'C':
+        loadStatusPixel = !loadStatusPixel;
+        break;
+      case 'm':
+        memoryReport();
+        break;
+      case 'x':
+        captureToggle();
+        break;
+      case 'g':
+        programToggle();
+        break;
+      case 'k':
+        teachToggle();
+        break;
+      case 'K':
+        teachErase();
+        break;
+      case 'S':
+        storeSaveConfig();
+        break;
+      case 'Z':
+        storeClear();
+        break;
+      case 'P':
+        storeSavePosition(0);
+        break;
+      case 'R':
+        storeRecallPosition(0);
+        break;
+      case 't':
+        if (telemetry.enabled & ~(TELEMETRY_MASK(TelemetryTrace) | TELEMETRY_MASK(TelemetryCommand) | TELEMETRY_MASK(TelemetryRecorder))) {
+          telemetry.enabled &= TELEMETRY_MASK(TelemetryTrace) | TELEMETRY_MASK(TelemetryCommand) | TELEMETRY_MASK(TelemetryRecorder);  // Command replies and a recorder dump stay on
+        } else {
+          telemetry.enabled |= TELEMETRY_MASK(TelemetryServo) | TELEMETRY_MASK(TelemetryDMX) | TELEMETRY_MASK(TelemetryLoop) | TELEMETRY_MASK(TelemetryStats);
+        }
+        break;
+      case 'b':
+        bootReport();
+        break;
+      case 'i':
+        governorReport();
+        break;
+      case 'j':
+        stallReport();
+        break;
+      case 'd':
+        traceEnable(traceMask ? 0 : LOG_ALL);
+        break;
+      case '?':
+        Serial.printf("Commands: p=profiler dump, r=profiler reset, t=telemetry on/off, d=trace on/off, l=DMX latency, f=freeze recorder, w=write recorder, a=arm recorder, c=CPU load, C=load on status pixel, m=memory, x=DMX capture, g=program play/stop, k=teach-in, K=erase for teach-in, S=save config, Z=clear config, P=save position, R=recall position, b=boot timeline, i=current and governor, j=stall detector\n");
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+
+// Binary record from the host, dispatched on its type byte
+void consoleRecord(const uint8_t* rec, uint32_t len) {
+  switch (rec[0]) {
+    case TelemetryCapture:
+      replayReceive(rec, len);
+      break;
+    case TelemetryCommand:
+      commandReceive(rec, len);
+      break;
+    case TelemetryStream:
+      streamReceive(rec, len);
+      break;
+    default:
+      break;
+  }
+}
+// ********************************************************************************
+
+
+// ********************************************************************************
+// Memory Report, static RAM listed by subsystem
+void memoryReport() {
+  const MemoryRegion region[] = {
+    { "dmx", sizeof(bufferDmx) + sizeof(dmxInput) },
+    { "servo", sizeof(C1_config_R) + sizeof(C1_run_R) + sizeof(DL) + sizeof(servoInstance) + sizeof(hardware) },
+    { "pixels", sizeof(pixelFrame) + sizeof(outputFrame) + sizeof(pixelExchange) + sizeof(pixels) },
+    { "eyes", sizeof(eyeLight) + sizeof(eyePresets) + sizeof(eyeCompositor) + sizeof(eyeFlicker) },
+    { "telemetry", sizeof(telemetry) + sizeof(traceRing0) + sizeof(traceRing1) + sizeof(consoleFrames) },
+#if RS5_RECORDER
+    { "recorder", sizeof(flightRecorder) },
+#endif
+#if RS5_CAPTURE
+    { "capture", sizeof(dmxCapture) + sizeof(dmxReplay) },
+#endif
+    { "program", sizeof(programPlayer) },
+#if RS5_TEACH
+    { "teach", sizeof(teachRecorder) },
+#endif
+#if RS5_STORE
+    { "store", sizeof(configStore) },
+#endif
+#if RS5_COMMAND
+    { "command", sizeof(commandChannel) },
+#endif
+#if RS5_STREAM
+    { "stream", sizeof(streamPlayer) },
+#endif
+    { "boot", sizeof(bootTimeline) },
+#if RS5_GOVERNOR
+    { "governor", sizeof(currentSense) + sizeof(motionGovernor) },
+#endif
+#if RS5_STALL
+    { "stall", sizeof(stallDetector) },
+#endif
+#if RS5_PROFILER
+    { "profiler", sizeof(profileStat) + sizeof(dmxLatency) + sizeof(coreLoad) },
+#endif
+  };
+  memoryMonitor.dump(region, sizeof(region) / sizeof(region[0]));
+}
+// ********************************************************************************
@@ -0,0 +1,183 @@
+// ============================================================================
+// File: motion_bench.cpp
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host benchmark of Derivs_Limiter::_calc(), ns per call across
+//              the motion profiles the servos run through
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+//
+// Usage:
+//   motion_bench                          all profiles, default sizes
+//   motion_bench --profile braking        one profile
+//   motion_bench --iterations 200000 --repeats 9 --tick 100
+//
+// Each profile sets up one limiter with the yaw servo limits from
+// RS5Hardware.h (the only axis with decel != accel) and calls calc() once per
+// virtual tick. A cheap step() keeps the limiter in the phase being measured,
+// its cost is included. The checksum is the sum of all positions, if an
+// optimization changes it the motion changed too.
+
+#include <Arduino.h>
+#include "ServoEngine.h"
+#include "RS5Hardware.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+//**********************************************************************************
+// Profiles
+struct Profile {
+  const char* name;
+  const char* what;
+  void (*setup)(Derivs_Limiter& dl);
+  void (*step)(Derivs_Limiter& dl, uint32_t n);
+};
+
+static Derivs_Limiter yaw(float target, float pos, float vel) {
+  return Derivs_Limiter(YAW_SERVO_MAXVEL, YAW_SERVO_MAXACC, YAW_SERVO_MAXDEC, target, pos, vel, false, false, -INFINITY, INFINITY);
+}
+
+// At the target and stopped, calc() returns early
+static void settledSetup(Derivs_Limiter& dl) {
+  dl = yaw(YAW_START_POS, YAW_START_POS, 0);
+}
+static void settledStep(Derivs_Limiter&, uint32_t) {}
+
+// Speeding up across the travel, restarted once at the velocity limit
+static void accelSetup(Derivs_Limiter& dl) {
+  dl = yaw(YAW_SERVO_MAXDEG, YAW_SERVO_MINDEG, 0);
+}
+static void accelStep(Derivs_Limiter& dl, uint32_t) {
+  if (dl.getVelocity() >= dl.getVelLimit()) dl.setPositionVelocity(YAW_SERVO_MINDEG, 0);
+}
+
+// Full speed inside the stopping distance, restarted once stopped
+static void brakeSetup(Derivs_Limiter& dl) {
+  dl = yaw(40, 0, YAW_SERVO_MAXVEL);
+}
+static void brakeStep(Derivs_Limiter& dl, uint32_t) {
+  if (dl.getVelocity() == 0) dl.setPositionVelocity(0, YAW_SERVO_MAXVEL);
+}
+
+// Velocity mode, reversing every 2000 ticks
+static void velSetup(Derivs_Limiter& dl) {
+  dl = yaw(YAW_START_POS, YAW_START_POS, 0);
+  dl.setVelTarget(YAW_SERVO_MAXVEL);
+}
+static void velStep(Derivs_Limiter& dl, uint32_t n) {
+  if (n % 2000 == 0) dl.setVelTarget((n / 2000) & 1 ? -YAW_SERVO_MAXVEL : YAW_SERVO_MAXVEL);
+}
+
+// 0.4s timed moves between 30 and 150 degrees every 2500 ticks
+static void timedSetup(Derivs_Limiter& dl) {
+  dl = yaw(YAW_START_POS, YAW_START_POS, 0);
+}
+static void timedStep(Derivs_Limiter& dl, uint32_t n) {
+  if (n % 2500 == 0) dl.setTargetTimedMovePreferred((n / 2500) & 1 ? 30 : 150, 0.4);
+}
+
+// What setServoPositions() sees: setTarget() every tick from a 44Hz DMX sine
+static uint32_t benchTickUs = 200;
+static void dmxSetup(Derivs_Limiter& dl) {
+  dl = yaw(YAW_START_POS, YAW_START_POS, 0);
+}
+static void dmxStep(Derivs_Limiter& dl, uint32_t n) {
+  uint32_t frame = (uint64_t)n * benchTickUs / 22727;
+  uint8_t dmx = 127.5f + 127.5f * sinf(frame * 0.05f);
+  dl.setTarget(YAW_SERVO_MINDEG + dmx * (YAW_SERVO_MAXDEG - YAW_SERVO_MINDEG) / 255.0f);
+}
+
+static const Profile profiles[] = {
+  { "settled", "stopped at target", settledSetup, settledStep },
+  { "accelerating", "speeding up to velLimit", accelSetup, accelStep },
+  { "braking", "decelerating into target", brakeSetup, brakeStep },
+  { "velocity", "velocity mode reversals", velSetup, velStep },
+  { "timed", "0.4s timed moves", timedSetup, timedStep },
+  { "dmx", "44Hz DMX sine cue", dmxSetup, dmxStep },
+};
+
+//**********************************************************************************
+// Runner
+struct Result {
+  double bestNs;
+  double medianNs;
+  double checksum;
+};
+
+static Result runProfile(const Profile& p, uint32_t iterations, int repeats) {
+  std::vector<double> ns;
+  double checksum = 0;
+  for (int r = 0; r < repeats; r++) {
+    Derivs_Limiter dl;
+    hostClockSet(1000000);
+    p.setup(dl);
+    dl.calc();  // First calc() only latches the clock
+    double sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < iterations; n++) {
+      p.step(dl, n);
+      hostClockAdvance(benchTickUs);
+      sum += dl.calc();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    ns.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+    checksum = sum;
+  }
+  std::sort(ns.begin(), ns.end());
+  return { ns.front(), ns[ns.size() / 2], checksum };
+}
+
+static void usage() {
+  fprintf(stderr, "usage: motion_bench [--profile name] [--iterations n] [--repeats n] [--tick us]\n");
+}
+
+int main(int argc, char** argv) {
+  const char* only = NULL;
+  uint32_t iterations = 1000000;
+  int repeats = 5;
+
+  for (int a = 1; a < argc; a++) {
+    if (a + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    if (!strcmp(argv[a], "--profile")) only = argv[++a];
+    else if (!strcmp(argv[a], "--iterations")) iterations = strtoul(argv[++a], NULL, 0);
+    else if (!strcmp(argv[a], "--repeats")) repeats = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--tick")) benchTickUs = strtoul(argv[++a], NULL, 0);
+    else {
+      usage();
+      return 2;
+    }
+  }
+  if (iterations == 0 || repeats < 1 || benchTickUs == 0) {
+    usage();
+    return 2;
+  }
+
+  printf("Derivs_Limiter::_calc(), %lu calls x %d repeats, tick %lu us\n", (unsigned long)iterations, repeats, (unsigned long)benchTickUs);
+  printf("%-13s %-26s %9s %9s %16s\n", "profile", "", "best ns", "median ns", "checksum");
+
+  int ran = 0;
+  bool ok = true;
+  for (const Profile& p : profiles) {
+    if (only && strcmp(only, p.name)) continue;
+    Result r = runProfile(p, iterations, repeats);
+    printf("%-13s %-26s %9.2f %9.2f %16.6e\n", p.name, p.what, r.bestNs, r.medianNs, r.checksum);
+    if (!std::isfinite(r.checksum)) ok = false;
+    ran++;
+  }
+  if (ran == 0) {
+    fprintf(stderr, "no profile named %s\n", only);
+    return 2;
+  }
+  return ok ? 0 : 1;
+}
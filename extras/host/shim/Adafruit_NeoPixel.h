@@ -0,0 +1,68 @@
+// ============================================================================
+// File: Adafruit_NeoPixel.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, NeoPixel strip that hands every show() to the
+//              runtime
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+#define NEO_RGB     ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRB     ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800  0x0000
+
+void hostPixelsShow(const uint32_t* color, uint16_t n, uint8_t brightness);
+
+class Adafruit_NeoPixel {
+public:
+  uint16_t n;
+  uint8_t brightness;
+  uint32_t color[64];
+
+public:
+  Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type) {
+    (void)pin;
+    (void)type;
+    n = count < 64 ? count : 64;
+    brightness = 0;
+    memset(color, 0, sizeof(color));
+  }
+
+  void begin() {}
+  void show() {
+    hostPixelsShow(color, n, brightness);
+  }
+  bool canShow() {
+    return true;
+  }
+  void clear() {
+    memset(color, 0, sizeof(color));
+  }
+  void setBrightness(uint8_t b) {
+    brightness = b + 1;  // Stored like the library, 0 means full
+  }
+  uint8_t getBrightness() const {
+    return brightness - 1;
+  }
+  void setPixelColor(uint16_t i, uint32_t c) {
+    if (i < n) color[i] = c;
+  }
+  void setPixelColor(uint16_t i, uint8_t r, uint8_t g, uint8_t b) {
+    setPixelColor(i, Color(r, g, b));
+  }
+  uint32_t getPixelColor(uint16_t i) const {
+    return i < n ? color[i] : 0;
+  }
+  uint16_t numPixels() const {
+    return n;
+  }
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+};
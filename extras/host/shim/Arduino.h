@@ -0,0 +1,176 @@
+// ============================================================================
+// File: Arduino.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim for the parts of the arduino-pico core the sketch
+//              uses, backed by a virtual clock the host runtime steps
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#ifndef _RS5_HOST_ARDUINO_H_
+#define _RS5_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <cmath>
+
+//**********************************************************************************
+// Types and math, same meaning as the Arduino core
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int uint;
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+
+#define ARDUINO_ARCH_RP2040 1
+
+using std::abs;
+using std::isnan;
+
+template<typename T>
+inline T sq(T x) {
+  return x * x;
+}
+
+template<typename T, typename L, typename H>
+inline T constrain(T x, L low, H high) {
+  return x < low ? low : (x > high ? high : x);
+}
+
+template<typename A, typename B>
+inline A max(A a, B b) {
+  return a > b ? a : b;
+}
+
+template<typename A, typename B>
+inline A min(A a, B b) {
+  return a < b ? a : b;
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+//**********************************************************************************
+// Host runtime
+//
+// Nothing advances on its own. host_clock.cpp keeps one clock that single
+// threaded tools step by hand; the simulator keeps one per core and charges
+// it for clock reads and delays. 32 bits like the RP2040 timer.
+uint32_t hostTimeUs();                // Virtual time of the calling core
+void hostClockSet(uint32_t us);
+void hostClockAdvance(uint32_t us);
+int hostCoreNum();
+
+// Pins, console and PRNG, only the simulator implements these
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+int analogRead(int pin);
+void analogReadResolution(int bits);
+long random(long high);
+long random(long low, long high);
+void randomSeed(unsigned long seed);
+void hostSerialWrite(const uint8_t* data, size_t len);
+int hostSerialAvailable();
+int hostSerialRead();
+
+inline unsigned long micros() {
+  return hostTimeUs();
+}
+
+inline unsigned long millis() {
+  return hostTimeUs() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+  hostClockAdvance(ms * 1000);
+}
+
+inline void delayMicroseconds(unsigned int us) {
+  hostClockAdvance(us);
+}
+
+inline uint32_t get_core_num() {
+  return hostCoreNum();
+}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+//**********************************************************************************
+// USB serial, output goes to the runtime's serial sink
+class SerialUSB {
+public:
+  void begin(unsigned long) {}
+  operator bool() {
+    return true;
+  }
+  int available() {
+    return hostSerialAvailable();
+  }
+  int read() {
+    return hostSerialRead();
+  }
+  int availableForWrite() {
+    return 4096;
+  }
+  size_t write(uint8_t c) {
+    hostSerialWrite(&c, 1);
+    return 1;
+  }
+  size_t write(const uint8_t* data, size_t len) {
+    hostSerialWrite(data, len);
+    return len;
+  }
+  void flush() {}
+  size_t print(const char* s) {
+    return write((const uint8_t*)s, strlen(s));
+  }
+  size_t println(const char* s) {
+    return print(s) + print("\n");
+  }
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[512];
+    va_list ap;
+    va_start(ap, format);
+    int n = vsnprintf(buf, sizeof(buf), format, ap);
+    va_end(ap);
+    if (n > 0) write((const uint8_t*)buf, n < (int)sizeof(buf) ? n : sizeof(buf) - 1);
+    return n;
+  }
+};
+
+inline SerialUSB Serial;
+
+//**********************************************************************************
+// rp2040 object, heap figures are fixed on the host
+class RP2040 {
+public:
+  int getTotalHeap() {
+    return 200 * 1024;
+  }
+  int getFreeHeap() {
+    return 150 * 1024;
+  }
+  int getUsedHeap() {
+    return getTotalHeap() - getFreeHeap();
+  }
+  void idleOtherCore() {}  // Both cores are coroutines on one thread
+  void resumeOtherCore() {}
+};
+
+inline RP2040 rp2040;
+
+#endif
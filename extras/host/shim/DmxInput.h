@@ -0,0 +1,72 @@
+// ============================================================================
+// File: DmxInput.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, DMX receiver fed with frames by the simulator
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+#define DMXINPUT_BUFFER_SIZE(start_channel, num_channels) \
+  ((start_channel + num_channels + 1) + ((4 - (start_channel + num_channels + 1) % 4) % 4))
+
+class DmxInput;
+void hostDmxAttach(DmxInput* input);
+
+class DmxInput {
+public:
+  enum return_code {
+    SUCCESS = 0,
+    ERR_NO_SM_AVAILABLE = -1,
+    ERR_INSUFFICIENT_PRGM_MEM = -2
+  };
+
+  uint pinNum;
+  uint startChannel;
+  uint numChannels;
+  volatile uint8_t* buffer;
+  void (*callback)(DmxInput* instance);
+  volatile unsigned long lastPacketMs;
+
+public:
+  DmxInput() {
+    pinNum = 0;
+    startChannel = 0;
+    numChannels = 0;
+    buffer = NULL;
+    callback = NULL;
+    lastPacketMs = 0;
+  }
+
+  return_code begin(uint pin, uint start_channel, uint num_channels) {
+    pinNum = pin;
+    startChannel = start_channel;
+    numChannels = num_channels;
+    return SUCCESS;
+  }
+
+  void read_async(volatile uint8_t* buf, void (*inputUpdatedCallback)(DmxInput* instance) = nullptr) {
+    buffer = buf;
+    callback = inputUpdatedCallback;
+    hostDmxAttach(this);
+  }
+
+  unsigned long latest_packet_timestamp() {
+    return lastPacketMs;
+  }
+
+  uint pin() {
+    return pinNum;
+  }
+
+  // Stops delivery until the next read_async()
+  void end() {
+    buffer = NULL;
+    callback = NULL;
+  }
+};
@@ -0,0 +1,28 @@
+// ============================================================================
+// File: FreeRTOS.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, FreeRTOS types used by the sketch
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t StackType_t;
+typedef void* TaskHandle_t;
+
+#define pdFALSE  0
+#define pdTRUE   1
+#define pdPASS   1
+#define pdFAIL   0
+
+#define configMINIMAL_STACK_SIZE  256
+#define tskIDLE_PRIORITY          0
+#define pdMS_TO_TICKS(ms)         ((TickType_t)(ms))
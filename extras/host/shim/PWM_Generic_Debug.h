@@ -0,0 +1,15 @@
+// ============================================================================
+// File: PWM_Generic_Debug.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, PWM library logging compiled out
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#define PWM_LOGERROR1(...)
+#define PWM_LOGINFO3(...)
+#define PWM_LOGINFO7(...)
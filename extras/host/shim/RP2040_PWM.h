@@ -0,0 +1,11 @@
+// ============================================================================
+// File: RP2040_PWM.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, the class itself comes from ServoDriver.h
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
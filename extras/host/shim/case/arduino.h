@@ -0,0 +1,11 @@
+// ============================================================================
+// File: arduino.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Lower case alias, the sketch includes <arduino.h>
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <Arduino.h>
@@ -0,0 +1,31 @@
+// ============================================================================
+// File: hardware/adc.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, the pico SDK ADC calls RS5Governor.h makes. The
+//              simulator converts the analog inputs at the configured rate
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct {
+  volatile uint32_t fifo;
+} adc_hw_t;
+
+extern adc_hw_t simAdcHw;
+#define adc_hw (&simAdcHw)
+
+#define DREQ_ADC  36
+
+void adc_init();
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain();
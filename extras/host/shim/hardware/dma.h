@@ -0,0 +1,61 @@
+// ============================================================================
+// File: hardware/dma.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, the pico SDK DMA calls RS5Governor.h makes. One
+//              channel paced by the ADC, written by the simulator
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+enum dma_channel_transfer_size {
+  DMA_SIZE_8 = 0,
+  DMA_SIZE_16 = 1,
+  DMA_SIZE_32 = 2
+};
+
+typedef struct {
+  uint size;
+  bool readIncrement;
+  bool writeIncrement;
+  bool ringWrite;
+  uint ringBits;  // 0 no ring
+  uint dreq;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr, const volatile void* read_addr,
+                           uint32_t transfer_count, bool trigger);
+bool dma_channel_is_busy(uint channel);
+
+inline dma_channel_config dma_channel_get_default_config(uint channel) {
+  (void)channel;
+  dma_channel_config c = { DMA_SIZE_32, true, false, false, 0, 0x3f };
+  return c;
+}
+
+inline void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size) {
+  c->size = size;
+}
+
+inline void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+  c->readIncrement = incr;
+}
+
+inline void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+  c->writeIncrement = incr;
+}
+
+inline void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits) {
+  c->ringWrite = write;
+  c->ringBits = size_bits;
+}
+
+inline void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+  c->dreq = dreq;
+}
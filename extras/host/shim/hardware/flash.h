@@ -0,0 +1,26 @@
+// ============================================================================
+// File: hardware/flash.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, flash programming into the simulated FS area
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLASH_PAGE_SIZE    (1u << 8)
+#define FLASH_SECTOR_SIZE  (1u << 12)
+#define FLASH_BLOCK_SIZE   (1u << 16)
+#define XIP_BASE           0x10000000
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#endif
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count);
@@ -0,0 +1,56 @@
+// ============================================================================
+// File: hardware/pwm.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, the pico SDK PWM calls ServoDriver.h makes. The
+//              simulator keeps slice and channel state to turn it into pulse widths
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef struct {
+  uint32_t csr;
+  uint32_t div;
+  uint32_t top;
+} pwm_config;
+
+enum pwm_chan {
+  PWM_CHAN_A = 0,
+  PWM_CHAN_B = 1
+};
+
+#define GPIO_FUNC_PWM  4
+
+inline uint pwm_gpio_to_slice_num(uint gpio) {
+  return (gpio >> 1) & 7;
+}
+
+inline uint pwm_gpio_to_channel(uint gpio) {
+  return gpio & 1;
+}
+
+inline pwm_config pwm_get_default_config() {
+  pwm_config c = { 0, 1 << 4, 0xffff };
+  return c;
+}
+
+inline void pwm_config_set_clkdiv_int(pwm_config* c, uint div) {
+  c->div = div << 4;
+}
+
+inline void pwm_config_set_wrap(pwm_config* c, uint16_t wrap) {
+  c->top = wrap;
+}
+
+void gpio_set_function(uint gpio, int fn);
+void pwm_init(uint slice, pwm_config* c, bool start);
+void pwm_set_wrap(uint slice, uint16_t wrap);
+void pwm_set_phase_correct(uint slice, bool phaseCorrect);
+void pwm_set_chan_level(uint slice, uint chan, uint16_t level);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+void pwm_set_enabled(uint slice, bool enabled);
@@ -0,0 +1,17 @@
+// ============================================================================
+// File: hardware/timer.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, microsecond timer on the virtual clock
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include <Arduino.h>
+
+inline uint32_t time_us_32() {
+  return hostTimeUs();
+}
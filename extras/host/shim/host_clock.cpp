@@ -0,0 +1,31 @@
+// ============================================================================
+// File: host_clock.cpp
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Single virtual clock for host tools that step time by hand
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include <Arduino.h>
+
+// Start past zero, Derivs_Limiter treats lastTime 0 as not started. One
+// clock per thread so the test workers each drive their own.
+static thread_local uint32_t hostClockUs = 1000000;
+
+uint32_t hostTimeUs() {
+  return hostClockUs;
+}
+
+void hostClockSet(uint32_t us) {
+  hostClockUs = us;
+}
+
+void hostClockAdvance(uint32_t us) {
+  hostClockUs += us;
+}
+
+int hostCoreNum() {
+  return 0;
+}
@@ -0,0 +1,24 @@
+// ============================================================================
+// File: task.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host shim, tasks. Extra tasks are accepted but never run, the
+//              simulator only schedules the two Arduino loops
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param, UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreateAffinitySet(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param, UBaseType_t priority,
+                                  UBaseType_t mask, TaskHandle_t* handle);
+void vTaskCoreAffinitySet(TaskHandle_t task, UBaseType_t mask);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
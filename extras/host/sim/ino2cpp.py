@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: ino2cpp.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Turn the sketch into a C++ file for the host build, adding the
+#              function prototypes the Arduino builder would generate
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   ino2cpp.py SkullMasterV2.ino SkullMasterV2.ino.cpp
+#
+# Prototypes for every top level function definition go after the last
+# #include, where the Arduino builder puts them. #line keeps compiler errors
+# pointing into the .ino.
+
+import re
+import sys
+
+DEFINITION = re.compile(r"^([A-Za-z_][\w:<>\*&\s]*?[\s\*&])([A-Za-z_]\w*)\s*\(([^;{}]*)\)\s*\{", re.M)
+INCLUDE = re.compile(r"^#include.*$", re.M)
+KEYWORDS = {"if", "while", "for", "switch", "return", "else"}
+
+
+def prototypes(src):
+    out = []
+    for m in DEFINITION.finditer(src):
+        ret, name, args = m.group(1).strip(), m.group(2), m.group(3)
+        if ret in KEYWORDS or name in KEYWORDS:
+            continue
+        out.append(f"{ret} {name}({args});")
+    return out
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: ino2cpp.py sketch.ino out.cpp")
+    path = sys.argv[1]
+    src = open(path).read()
+    split = [m.end() for m in INCLUDE.finditer(src)][-1]
+    head_lines = src[:split].count("\n") + 1
+    with open(sys.argv[2], "w") as f:
+        f.write("#include <Arduino.h>\n")
+        f.write(f'#line 1 "{path}"\n')
+        f.write(src[:split] + "\n")
+        f.write("\n".join(prototypes(src)) + "\n")
+        f.write(f'#line {head_lines + 1} "{path}"\n')
+        f.write(src[split + 1:])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,155 @@
+// ============================================================================
+// File: sim.h
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host simulator runtime, two cooperative cores on virtual
+//              clocks and the hardware the sketch talks to
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#ifndef _RS5_SIM_H_
+#define _RS5_SIM_H_
+
+#include <Arduino.h>
+#include <DmxInput.h>
+#include <hardware/adc.h>
+#include <hardware/dma.h>
+#include <ucontext.h>
+#include <deque>
+
+//**********************************************************************************
+// Simulator
+//
+// setup()/loop() and setup1()/loop1() each run on their own coroutine with
+// their own virtual clock, like the two RP2040 cores. step() resumes the
+// core that is furthest behind; it runs until a clock read or delay() puts it
+// more than sliceUs ahead of the other core. Clock reads are charged
+// readCostUs, which is what moves time in loops that never sleep (loop1()),
+// and NeoPixel show() is charged its wire time. Cross core effects are
+// therefore exact to within one slice.
+//
+// Nothing here knows about the sketch. The driver (sim_main.cpp) feeds DMX
+// frames, serial input and pin levels at the virtual time they happen, and
+// reads servo pulses and pixel colours back from the change history.
+#define SIM_CORES       2
+#define SIM_GPIO        30
+#define SIM_PWM_SLICES  8
+#define SIM_PIXELS      64
+#define SIM_STACK_SIZE  (256 * 1024)
+#define SIM_CLK_HZ      125000000  // PWM clock, clk_sys at reset
+#define SIM_FS_SIZE     (64 * 1024)
+#define SIM_ADC_CLK_HZ  48000000
+
+class SimCore {
+public:
+  ucontext_t ctx;
+  uint64_t timeUs;
+  uint8_t* stack;
+  void (*setupFn)();
+  void (*loopFn)();
+};
+
+class SimSlice {
+public:
+  uint32_t top;
+  uint32_t div;  // 8.4 fixed point like the PWM DIV register
+  bool enabled;
+  uint16_t level[2];
+};
+
+// An output change, stamped with the virtual time of the core that made it
+template<typename T>
+class SimChange {
+public:
+  uint64_t timeUs;
+  T value;
+};
+
+class SimPixels {
+public:
+  uint16_t n;
+  uint32_t color[SIM_PIXELS];
+};
+
+class Simulator {
+public:
+  // Cost model
+  uint32_t readCostUs;
+  uint32_t sliceUs;
+  uint32_t pixelUs;    // show() per pixel, 24 bits at 800kHz
+  uint32_t latchUs;    // show() reset gap
+
+  SimCore core[SIM_CORES];
+  ucontext_t mainCtx;
+  int current;         // Core running, -1 while the driver runs
+  uint64_t eventUs;    // Time seen by driver side callbacks (DMX interrupt)
+
+  // GPIO
+  uint8_t inputLevel[SIM_GPIO];
+  uint8_t outputLevel[SIM_GPIO];
+  int analogValue[SIM_GPIO];
+  bool pwmFunction[SIM_GPIO];
+
+  // PWM
+  SimSlice slice[SIM_PWM_SLICES];
+  float pulseNow[SIM_GPIO];                          // Pulse width as last written, us
+  std::deque<SimChange<float> > pulseLog[SIM_GPIO];  // Writes not yet sampled
+  float pulseSampled[SIM_GPIO];
+
+  // NeoPixels
+  std::deque<SimChange<SimPixels> > pixelLog;
+  SimPixels pixelsSampled;
+  uint32_t pixelShows;
+
+  // ADC, free running into the one DMA channel the sketch claims
+  bool adcRunning;
+  uint adcInput;
+  float adcDiv;
+  double adcPhaseUs;                                 // Time of the next conversion
+  volatile uint16_t* dmaWrite;
+  uint32_t dmaRingMask;                              // Entries - 1, 0 without a ring
+  uint32_t dmaIndex;
+  uint32_t dmaCount;                                 // Transfers left
+  int dmaClaimed;
+
+  // DMX receiver
+  DmxInput* dmx;
+  uint32_t dmxFrames;
+
+  // Serial
+  std::deque<uint8_t> serialIn;
+  FILE* serialOut;
+
+  uint32_t randomState;
+
+public:
+  Simulator();
+
+  // Driver side
+  void boot(void (*setup0)(), void (*loop0)(), void (*setup1)(), void (*loop1)());
+  uint64_t now();      // Time of the core furthest behind, everything before it is final
+  void step();
+  void setInput(int pin, int level);
+  void setAnalog(int pin, int value);
+  void typeSerial(const char* s);
+  void dmxFrame(uint64_t us, const uint8_t* data, int len);
+  void adcConvert(uint64_t us);
+  float pulseAt(int gpio, uint64_t us);
+  const SimPixels& pixelsAt(uint64_t us);
+
+  // Core side
+  uint32_t timeUs();
+  void charge(uint32_t us);
+  void yield();
+  void pwmChanged(uint s);
+  void pixelsShown(const uint32_t* color, uint16_t n);
+  uint32_t stackFree(int c);
+
+  static void entry(int c);
+};
+
+extern Simulator sim;
+
+#endif
@@ -0,0 +1,686 @@
+// ============================================================================
+// File: sim_main.cpp
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host simulator driver, runs the sketch on virtual time from a
+//              show script and writes servo pulses and pixel colours as CSV
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+//
+// Usage:
+//   rs5sim [options] show.txt > out.csv
+//     --address n     DMX start address on the dip switches (default 1)
+//     --island n      island switches 0-4, picks the eye channels (default 0)
+//     --debug n       debug level before boot (default 0)
+//     --sample ms     CSV row period (default 10)
+//     --end ms        stop time, overrides the script
+//     --serial file   console output (default stderr, "-" for stdout)
+//     --read-cost us  virtual time charged per clock read (default 2)
+//     --slice us      how far one core may run ahead of the other (default 100)
+//     --seed n        random() seed
+//     --replay file   DMX capture (RS5Capture.h) played in place of the script's
+//                     frames, straight into the receiver
+//     --replay-console file
+//                     the same capture sent to the console at the captured
+//                     times, the firmware replays it
+//     --replay-at ms  when the first captured frame plays (default its capture
+//                     time, so a capture made by rs5sim replays in step)
+//     --program file  choreography (RS5Program.h) written to the flash program
+//                     region before boot, console g plays it
+//
+// Show script, one event per line, times in ms, # starts a comment:
+//   0     rate 44              DMX frames per second
+//   0     ch 1 128 64          set channels 1 and 2 (absolute DMX channels)
+//   500   fade 1 255 1000      fade channel 1 to 255 over 1000ms
+//   2000  stop                 stop transmitting, the sketch sees DMX loss
+//   2500  start
+//   0     startcode 0
+//   3000  key p                console characters (\n for a newline)
+//   4000  mode demo            dmx | demo, the System run mode
+//   4000  analog 29 512        ADC input
+//   4000  current 100 300      servo supply current model on the current sense
+//                              input: 100 idle plus 300 per 100 deg/s the
+//                              servos move, ADC counts; current 0 0 turns it off
+//   4000  jam 2 500            servo 2 jammed, draws 500 more counts on top of
+//                              the current model while its PWM is on; jam 2 0
+//                              frees it
+//   4000  cmd set 0 maxvel 120 binary command (RS5Command.h): ping, get, set,
+//                              save, savepos, recall; servo, field name, value.
+//                              System fields take no servo: cmd set debuglevel 3
+//   5000  stream 1000 2000 5000 10
+//                              stream frames (RS5Stream.h) at 1000Hz for 2000ms,
+//                              each held up to 5000us on the way, 10 per mille
+//                              lost; all axes sweep once a second
+//   10000 end
+//
+// CSV columns: t_ms, servo<i>_us for each licensed servo (0 while the PWM is
+// off), pixel<i> as RRGGBB hex as passed to setPixelColor().
+
+#include "sim.h"
+#include "SkullMasterV2.ino.cpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+//**********************************************************************************
+// Show script
+enum simEventType {
+  SimEventRate,
+  SimEventChannels,
+  SimEventFade,
+  SimEventStop,
+  SimEventStart,
+  SimEventStartCode,
+  SimEventKey,
+  SimEventMode,
+  SimEventAnalog,
+  SimEventCommand,
+  SimEventStream,
+  SimEventCurrent,
+  SimEventJam,
+  SimEventEnd
+};
+
+class SimEvent {
+public:
+  uint64_t timeUs;
+  int type;
+  int channel;
+  std::vector<int> values;
+  std::string text;
+  CommandRecord command;
+};
+
+// Framed like the firmware sends it, 0x00 COBS 0x00
+static void simSendConsole(const void* rec, uint32_t len) {
+  uint8_t wire[TELEMETRY_FRAME_MAX];
+  uint32_t n = cobsEncode((const uint8_t*)rec, len, wire + 1) + 1;
+  wire[0] = 0;
+  wire[n++] = 0;
+  sim.serialIn.insert(sim.serialIn.end(), wire, wire + n);
+}
+
+//**********************************************************************************
+// Binary commands, names as rs5_command.py takes them
+static const struct {
+  const char* name;
+  uint8_t value;
+} simCommandOps[] = {
+  { "ping", CommandPing }, { "get", CommandGet }, { "set", CommandSet },
+  { "save", CommandSave }, { "savepos", CommandSavePosition }, { "recall", CommandRecallPosition },
+}, simCommandFields[] = {
+  { "licensed", CommandLicensed }, { "mindeg", CommandMinDeg }, { "maxdeg", CommandMaxDeg },
+  { "maxvel", CommandMaxVel }, { "maxacc", CommandMaxAcc }, { "maxdec", CommandMaxDec },
+  { "smooth", CommandSmooth }, { "minpwm", CommandMinPWM }, { "maxpwm", CommandMaxPWM },
+  { "sleep", CommandSleep }, { "servomindeg", CommandServoMinDeg }, { "servomaxdeg", CommandServoMaxDeg },
+  { "freq", CommandFreq }, { "startdeg", CommandStartDeg }, { "debuglevel", CommandDebugLevel },
+  { "debugservo", CommandDebugServo }, { "dmxaddress", CommandDMXAddress }, { "runmode", CommandRunMode },
+  { "packetagelimit", CommandPacketAgeLimit }, { "currentbudget", CommandCurrentBudget }, { "current", CommandCurrent },
+};
+
+// "set 0 maxvel 120", "get debuglevel", "savepos 1" into c, false if it doesn't parse
+static bool simParseCommand(const std::string& text, CommandRecord& c) {
+  static uint16_t tag = 0;
+  std::vector<std::string> w;
+  size_t at = 0;
+  while ((at = text.find_first_not_of(" \t\r\n", at)) != std::string::npos) {
+    size_t end = text.find_first_of(" \t\r\n", at);
+    w.push_back(text.substr(at, end == std::string::npos ? end : end - at));
+    at = end;
+  }
+  memset(&c, 0, sizeof(c));
+  c.type = TelemetryCommand;
+  c.tag = ++tag;
+  c.op = 0xFF;
+  for (auto& o : simCommandOps) {
+    if (!w.empty() && w[0] == o.name) c.op = o.value;
+  }
+  if (c.op == 0xFF) return false;
+  size_t k = 1;
+  if (k < w.size() && isdigit((unsigned char)w[k][0])) c.target = strtol(w[k++].c_str(), NULL, 0);
+  if (c.op == CommandGet || c.op == CommandSet) {
+    if (k >= w.size()) return false;
+    bool named = false;
+    for (auto& f : simCommandFields) {
+      if (w[k] == f.name) {
+        c.field = f.value;
+        named = true;
+      }
+    }
+    if (!named) return false;
+    k++;
+  }
+  if (c.op == CommandSet) {
+    if (k >= w.size()) return false;
+    c.value = strtod(w[k++].c_str(), NULL);
+  }
+  return k == w.size();
+}
+
+class SimFade {
+public:
+  bool active;
+  float from;
+  float to;
+  uint64_t startUs;
+  uint64_t endUs;
+};
+
+class SimShow {
+public:
+  std::vector<SimEvent> events;
+  size_t next;
+  std::vector<std::pair<uint64_t, StreamRecord>> stream;  // Send time, frame
+  size_t streamNext;
+  uint32_t streamRandom;
+  uint8_t frame[513];  // Start code and 512 channels
+  SimFade fade[513];
+  bool transmitting;
+  uint32_t frameUs;
+  uint64_t nextFrameUs;
+  uint64_t endUs;
+  int currentIdle;  // Current model, ADC counts, off while both are 0
+  int currentPer;
+  int jam[NUM_LIC_SERVOS];  // Stall current per servo, ADC counts
+
+public:
+  SimShow() {
+    next = 0;
+    streamNext = 0;
+    streamRandom = 0x2545F491;
+    memset(frame, 0, sizeof(frame));
+    for (int c = 0; c < 513; c++) fade[c].active = false;
+    transmitting = true;
+    frameUs = 1000000 / 44;
+    nextFrameUs = frameUs;
+    endUs = 0;
+    currentIdle = 0;
+    currentPer = 0;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) jam[i] = 0;
+  }
+
+  bool load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+      fprintf(stderr, "rs5sim: cannot open %s\n", path);
+      return false;
+    }
+    char line[1024];
+    int lineNum = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), f)) {
+      lineNum++;
+      char* hash = strchr(line, '#');
+      if (hash) *hash = 0;
+      if (!parse(line)) {
+        fprintf(stderr, "rs5sim: %s:%d: cannot parse event\n", path, lineNum);
+        ok = false;
+      }
+    }
+    fclose(f);
+    // Stable, so events at the same time keep their file order
+    std::stable_sort(events.begin(), events.end(), [](const SimEvent& a, const SimEvent& b) {
+      return a.timeUs < b.timeUs;
+    });
+    return ok;
+  }
+
+  bool parse(char* line) {
+    char* save;
+    char* tok = strtok_r(line, " \t\r\n", &save);
+    if (tok == NULL) return true;  // Blank
+    SimEvent e;
+    e.timeUs = (uint64_t)(strtod(tok, NULL) * 1000);
+    e.channel = 0;
+    char* cmd = strtok_r(NULL, " \t\r\n", &save);
+    if (cmd == NULL) return false;
+    std::vector<int> args;
+    std::string rest = save;  // Raw text for key and mode
+    for (char* a = strtok_r(NULL, " \t\r\n", &save); a; a = strtok_r(NULL, " \t\r\n", &save)) args.push_back(strtol(a, NULL, 0));
+
+    if (!strcmp(cmd, "rate") && args.size() == 1 && args[0] > 0) e.type = SimEventRate;
+    else if (!strcmp(cmd, "ch") && args.size() >= 2) e.type = SimEventChannels;
+    else if (!strcmp(cmd, "fade") && args.size() == 3) e.type = SimEventFade;
+    else if (!strcmp(cmd, "stop")) e.type = SimEventStop;
+    else if (!strcmp(cmd, "start")) e.type = SimEventStart;
+    else if (!strcmp(cmd, "startcode") && args.size() == 1) e.type = SimEventStartCode;
+    else if (!strcmp(cmd, "analog") && args.size() == 2) e.type = SimEventAnalog;
+    else if (!strcmp(cmd, "current") && args.size() == 2) e.type = SimEventCurrent;
+    else if (!strcmp(cmd, "jam") && args.size() == 2 && args[0] >= 0 && args[0] < NUM_LIC_SERVOS) e.type = SimEventJam;
+    else if (!strcmp(cmd, "end")) e.type = SimEventEnd;
+    else if (!strcmp(cmd, "stream") && args.size() >= 2 && args.size() <= 4 && args[0] > 0) e.type = SimEventStream;
+    else if (!strcmp(cmd, "cmd")) {
+      e.type = SimEventCommand;
+      if (!simParseCommand(rest, e.command)) return false;
+    }
+    else if (!strcmp(cmd, "key") || !strcmp(cmd, "mode")) {
+      e.type = !strcmp(cmd, "key") ? SimEventKey : SimEventMode;
+      e.text = rest.substr(rest.find_first_not_of(" \t") == std::string::npos ? rest.size() : rest.find_first_not_of(" \t"));
+      while (!e.text.empty() && strchr(" \t\r\n", e.text.back())) e.text.pop_back();
+      if (e.type == SimEventMode && e.text != "dmx" && e.text != "demo") return false;
+      size_t nl;
+      while ((nl = e.text.find("\\n")) != std::string::npos) e.text.replace(nl, 2, "\n");
+    } else {
+      return false;
+    }
+    if (e.type == SimEventChannels || e.type == SimEventFade || e.type == SimEventAnalog) {
+      e.channel = args[0];
+      e.values.assign(args.begin() + 1, args.end());
+      if (e.type != SimEventAnalog && (e.channel < 1 || e.channel > 512)) return false;
+    } else {
+      e.values = args;
+    }
+    if (e.type == SimEventEnd) endUs = e.timeUs;
+    events.push_back(e);
+    return true;
+  }
+
+  void apply(const SimEvent& e) {
+    switch (e.type) {
+      case SimEventRate:
+        frameUs = 1000000 / e.values[0];
+        break;
+      case SimEventChannels:
+        for (size_t v = 0; v < e.values.size() && e.channel + v <= 512; v++) {
+          frame[e.channel + v] = e.values[v];
+          fade[e.channel + v].active = false;
+        }
+        break;
+      case SimEventFade:
+        fade[e.channel] = { true, (float)frame[e.channel], (float)e.values[0], e.timeUs, e.timeUs + (uint64_t)e.values[1] * 1000 };
+        break;
+      case SimEventStop:
+        transmitting = false;
+        break;
+      case SimEventStart:
+        transmitting = true;
+        break;
+      case SimEventStartCode:
+        frame[0] = e.values[0];
+        break;
+      case SimEventKey:
+        sim.typeSerial(e.text.c_str());
+        break;
+      case SimEventMode:
+        systemState.mode = e.text == "demo" ? RunModeDemo : RunModeDMX;
+        break;
+      case SimEventAnalog:
+        sim.setAnalog(e.channel, e.values[0]);
+        break;
+      case SimEventCommand:
+        simSendConsole(&e.command, sizeof(e.command));
+        break;
+      case SimEventStream:
+        addStream(e);
+        break;
+      case SimEventCurrent:
+        currentIdle = e.values[0];
+        currentPer = e.values[1];
+        break;
+      case SimEventJam:
+        jam[e.values[0]] = e.values[1];
+        break;
+      case SimEventEnd:
+        break;
+    }
+  }
+
+  // Current sense input from how fast the licensed servos move, plus the
+  // stall current of jammed servos that are driven
+  void current() {
+    if (currentIdle == 0 && currentPer == 0) return;
+    float speed = 0;
+    int stall = 0;
+    for (int i = 0; i < NUM_LIC_SERVOS; i++) {
+      if (C1_config_R[i].licensed) speed += fabsf(DL[i].getVelocity());
+      if (C1_run_R[i].PwmEnabled) stall += jam[i];
+    }
+    int v = currentIdle + (int)(currentPer * speed / 100) + stall;
+    sim.setAnalog(CURRENT_SENSE_PIN, v > 1023 ? 1023 : v);
+  }
+
+  uint32_t nextRandom() {
+    streamRandom ^= streamRandom << 13;
+    streamRandom ^= streamRandom >> 17;
+    streamRandom ^= streamRandom << 5;
+    return streamRandom;
+  }
+
+  // Frames from now on, held back by up to jitter us on the way but kept in
+  // order like USB does, so a held frame delays the ones behind it
+  void addStream(const SimEvent& e) {
+    uint32_t periodUs = 1000000 / e.values[0];
+    uint32_t count = (uint64_t)e.values[1] * 1000 / periodUs;
+    uint32_t jitter = e.values.size() > 2 ? e.values[2] : 0;
+    uint32_t loss = e.values.size() > 3 ? e.values[3] : 0;
+    uint32_t hostBase = 0xFFF00000;  // Wraps during the stream
+    uint64_t sendUs = e.timeUs;
+    static uint16_t seq = 0;
+    for (uint32_t k = 0; k <= count; k++) {
+      StreamRecord r;
+      memset(&r, 0, sizeof(r));
+      r.type = TelemetryStream;
+      r.flags = k == count ? StreamEnd : StreamEyes;
+      r.seq = seq++;
+      r.timeUs = hostBase + k * periodUs;
+      r.eyes = 128;
+      for (int i = 0; i < NUM_LIC_SERVOS; i++) r.level[i] = 32767.5f + 32767.5f * sinf(2 * (float)M_PI * k * periodUs / 1e6f);
+      if (k < count && loss && nextRandom() % 1000 < loss) continue;
+      uint64_t at = e.timeUs + (uint64_t)k * periodUs + (jitter ? nextRandom() % jitter : 0);
+      if (at > sendUs) sendUs = at;
+      stream.push_back(std::make_pair(sendUs, r));
+    }
+  }
+
+  uint64_t streamUs() {
+    return streamNext < stream.size() ? stream[streamNext].first : UINT64_MAX;
+  }
+
+  // Channel levels at time us, fades applied
+  void render(uint64_t us) {
+    for (int c = 1; c < 513; c++) {
+      SimFade& f = fade[c];
+      if (!f.active) continue;
+      if (us >= f.endUs) {
+        frame[c] = f.to;
+        f.active = false;
+      } else {
+        frame[c] = f.from + (f.to - f.from) * (float)(us - f.startUs) / (f.endUs - f.startUs) + 0.5f;
+      }
+    }
+  }
+};
+
+//**********************************************************************************
+// DMX capture, the TelemetryCapture frames from a capture file. Console text
+// between the frames is skipped.
+class SimCaptureFrame {
+public:
+  uint32_t timeUs;  // Capture clock
+  CaptureRecord record;
+  uint32_t recordLen;
+};
+
+class SimCapture {
+public:
+  std::vector<SimCaptureFrame> frames;
+  size_t next;
+  uint64_t startUs;   // Virtual time of the first frame
+  uint32_t firstUs;   // Capture time of the first frame
+  bool console;       // Send to the console instead of the receiver
+  uint16_t channel[CAPTURE_CHANNELS_MAX];
+  uint8_t count;
+  uint8_t frame[513];
+  uint32_t played;
+
+public:
+  SimCapture() {
+    next = 0;
+    startUs = UINT64_MAX;
+    firstUs = 0;
+    console = false;
+    count = 0;
+    memset(frame, 0, sizeof(frame));
+    played = 0;
+  }
+
+  bool load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+      fprintf(stderr, "rs5sim: cannot open %s\n", path);
+      return false;
+    }
+    FrameReader reader;
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+      if (!reader.feed(c) || reader.recordLen == 0) continue;
+      if (reader.record[0] == TelemetryCapture && reader.recordLen >= CAPTURE_HEADER_SIZE) {
+        SimCaptureFrame e;
+        memcpy(&e.record, reader.record, reader.recordLen);
+        e.recordLen = reader.recordLen;
+        if (e.recordLen == captureRecordSize(e.record)) {
+          e.timeUs = e.record.timeUs;
+          frames.push_back(e);
+        }
+      }
+    }
+    fclose(f);
+    // Replay starts at the first patch, like the firmware
+    while (!frames.empty() && !(frames.front().record.flags & CapturePatch)) frames.erase(frames.begin());
+    if (frames.empty()) {
+      fprintf(stderr, "rs5sim: %s holds no DMX capture\n", path);
+      return false;
+    }
+    firstUs = frames.front().timeUs;
+    if (startUs == UINT64_MAX) startUs = firstUs;
+    return true;
+  }
+
+  // Virtual time the next frame is due, UINT64_MAX when done
+  uint64_t nextUs() {
+    if (next >= frames.size()) return console && next == frames.size() ? endUs() : UINT64_MAX;
+    return startUs + (uint32_t)(frames[next].timeUs - firstUs);
+  }
+
+  // CaptureEnd goes one frame period after the last frame
+  uint64_t endUs() {
+    return startUs + (uint32_t)(frames.back().timeUs - firstUs) + 1000000 / 44;
+  }
+
+  void apply(uint64_t us) {
+    if (next == frames.size()) {
+      CaptureRecord r;
+      memset(&r, 0, sizeof(r));
+      r.type = TelemetryCapture;
+      r.flags = CaptureEnd;
+      simSendConsole(&r, CAPTURE_HEADER_SIZE);
+      next++;
+      return;
+    }
+    const SimCaptureFrame& e = frames[next++];
+    if (console) {
+      simSendConsole(&e.record, e.recordLen);
+      return;
+    }
+    const CaptureRecord& r = e.record;
+    if (r.flags & CapturePatch) {
+      count = __builtin_popcount(r.mask);
+      if (count > CAPTURE_CHANNELS_MAX) count = CAPTURE_CHANNELS_MAX;
+      memcpy(channel, r.data, count * sizeof(channel[0]));
+      return;
+    }
+    uint8_t n = 0;
+    for (uint8_t k = 0; k < count; k++) {
+      if (r.mask & (1u << k)) {
+        if (channel[k] < sizeof(frame)) frame[channel[k]] = r.data[n];
+        n++;
+      }
+    }
+    sim.dmxFrame(us, frame, sizeof(frame));
+    played++;
+  }
+};
+
+//**********************************************************************************
+// Program a file into the flash program region, as picotool would
+static bool simFlashProgram(const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (f == NULL) {
+    fprintf(stderr, "rs5sim: cannot open %s\n", path);
+    return false;
+  }
+  static uint8_t image[FLASH_PROGRAM_SIZE];
+  memset(image, 0xff, sizeof(image));
+  size_t n = fread(image, 1, sizeof(image), f);
+  bool fits = fgetc(f) == EOF;
+  fclose(f);
+  if (!fits || !flashRegionAvailable(FLASH_PROGRAM_OFFSET, FLASH_PROGRAM_SIZE)) {
+    fprintf(stderr, "rs5sim: %s does not fit the flash program region\n", path);
+    return false;
+  }
+  uint32_t pages = (n + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+  flash_range_erase(flashRegionOffset(FLASH_PROGRAM_OFFSET), FLASH_PROGRAM_SIZE);
+  flash_range_program(flashRegionOffset(FLASH_PROGRAM_OFFSET), image, pages);
+  return true;
+}
+
+//**********************************************************************************
+// CSV output
+static void simHeader(FILE* out) {
+  fprintf(out, "t_ms");
+  for (int i = 0; i < NUM_LIC_SERVOS; i++) fprintf(out, ",servo%d_us", i);
+  for (int p = 0; p < NUMPIXELS; p++) fprintf(out, ",pixel%d", p);
+  fprintf(out, "\n");
+}
+
+static void simSample(FILE* out, uint64_t us) {
+  fprintf(out, "%.1f", us / 1000.0);
+  for (int i = 0; i < NUM_LIC_SERVOS; i++) fprintf(out, ",%.1f", sim.pulseAt(hardware[i].pin, us));
+  const SimPixels& px = sim.pixelsAt(us);
+  for (int p = 0; p < NUMPIXELS; p++) fprintf(out, ",%06x", p < px.n ? (unsigned)(px.color[p] & 0xffffff) : 0u);
+  fprintf(out, "\n");
+}
+
+//**********************************************************************************
+// Dip switches, closed switches read low
+static void simDipSwitches(int address, int island) {
+  const int addressPin[] = { DMX_BIT_1_PIN, DMX_BIT_2_PIN, DMX_BIT_4_PIN, DMX_BIT_8_PIN, DMX_BIT_16_PIN,
+                             DMX_BIT_32_PIN, DMX_BIT_64_PIN, DMX_BIT_128_PIN, DMX_BIT_256_PIN };
+  const int islandPin[] = { RUNMODE_BIT_1_PIN, RUNMODE_BIT_2_PIN, RUNMODE_BIT_4_PIN };
+  for (int b = 0; b < 9; b++) sim.setInput(addressPin[b], (address >> b) & 1 ? LOW : HIGH);
+  for (int b = 0; b < 3; b++) sim.setInput(islandPin[b], (island >> b) & 1 ? LOW : HIGH);
+}
+
+static void simUsage() {
+  fprintf(stderr, "usage: rs5sim [--address n] [--island n] [--debug n] [--sample ms] [--end ms] [--serial file]\n"
+                  "              [--read-cost us] [--slice us] [--seed n]\n"
+                  "              [--replay file | --replay-console file] [--replay-at ms] [--program file] show.txt\n");
+}
+
+int main(int argc, char** argv) {
+  int address = 1;
+  int island = 0;
+  int debug = 0;
+  uint32_t sampleUs = 10000;
+  uint64_t endUs = 0;
+  const char* serialPath = NULL;
+  const char* scriptPath = NULL;
+  const char* replayPath = NULL;
+  const char* programPath = NULL;
+  SimCapture capture;
+
+  for (int a = 1; a < argc; a++) {
+    bool value = a + 1 < argc;
+    if (!strcmp(argv[a], "--address") && value) address = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--island") && value) island = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--debug") && value) debug = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--sample") && value) sampleUs = strtod(argv[++a], NULL) * 1000;
+    else if (!strcmp(argv[a], "--end") && value) endUs = strtod(argv[++a], NULL) * 1000;
+    else if (!strcmp(argv[a], "--serial") && value) serialPath = argv[++a];
+    else if (!strcmp(argv[a], "--read-cost") && value) sim.readCostUs = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--slice") && value) sim.sliceUs = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--seed") && value) randomSeed(strtoul(argv[++a], NULL, 0));
+    else if (!strcmp(argv[a], "--replay") && value) replayPath = argv[++a];
+    else if (!strcmp(argv[a], "--replay-console") && value) {
+      replayPath = argv[++a];
+      capture.console = true;
+    }
+    else if (!strcmp(argv[a], "--replay-at") && value) capture.startUs = strtod(argv[++a], NULL) * 1000;
+    else if (!strcmp(argv[a], "--program") && value) programPath = argv[++a];
+    else if (argv[a][0] != '-' && scriptPath == NULL) scriptPath = argv[a];
+    else {
+      simUsage();
+      return 2;
+    }
+  }
+  if (scriptPath == NULL || sampleUs == 0 || sim.readCostUs == 0) {
+    simUsage();
+    return 2;
+  }
+
+  SimShow show;
+  if (!show.load(scriptPath)) return 2;
+  if (replayPath && !capture.load(replayPath)) return 2;
+  if (endUs == 0) endUs = show.endUs;
+  if (endUs == 0) {
+    fprintf(stderr, "rs5sim: no end time, add an 'end' event or --end\n");
+    return 2;
+  }
+  if (serialPath) sim.serialOut = strcmp(serialPath, "-") ? fopen(serialPath, "wb") : stdout;
+  if (sim.serialOut == NULL) {
+    fprintf(stderr, "rs5sim: cannot open %s\n", serialPath);
+    return 2;
+  }
+
+  if (programPath && !simFlashProgram(programPath)) return 2;
+  simDipSwitches(address, island);
+  systemState.debug = debug;  // Before setup(), as if compiled in
+  sim.boot(setup, loop, setup1, loop1);
+  simHeader(stdout);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint64_t nextSampleUs = 0;
+  uint64_t nextDrainUs = 0;
+  uint64_t nextAdcUs = 0;
+  while (true) {
+    uint64_t now = sim.now();
+
+    // Everything up to now, in time order
+    while (true) {
+      uint64_t eventUs = show.next < show.events.size() ? show.events[show.next].timeUs : UINT64_MAX;
+      uint64_t replayUs = replayPath ? capture.nextUs() : UINT64_MAX;
+      uint64_t streamUs = show.streamUs();
+      uint64_t t = eventUs;
+      if (replayUs < t) t = replayUs;
+      if (streamUs < t) t = streamUs;
+      if (show.nextFrameUs < t) t = show.nextFrameUs;
+      if (nextSampleUs < t) t = nextSampleUs;
+      if (nextDrainUs < t) t = nextDrainUs;
+      if (nextAdcUs < t) t = nextAdcUs;
+      if (t > now || t > endUs) break;
+      if (t == eventUs) {
+        show.apply(show.events[show.next++]);
+      } else if (t == nextDrainUs) {
+        // Tasks are never scheduled, this stands in for telemetryTask()
+        if (telemetry.enabled) {
+          telemetryPeriodic();
+          telemetry.drain();
+        }
+        nextDrainUs += telemetryDrainPeriod() * 1000;
+      } else if (t == nextAdcUs) {
+        show.current();
+        sim.adcConvert(t);
+        nextAdcUs += 1000;
+      } else if (t == replayUs) {
+        capture.apply(t);
+      } else if (t == streamUs) {
+        simSendConsole(&show.stream[show.streamNext].second, sizeof(StreamRecord));
+        show.streamNext++;
+      } else if (t == show.nextFrameUs) {
+        show.render(t);
+        // A host replay replaces the script's frames
+        if (show.transmitting && (replayPath == NULL || capture.console)) sim.dmxFrame(t, show.frame, sizeof(show.frame));
+        show.nextFrameUs += show.frameUs;
+      } else {
+        simSample(stdout, t);
+        nextSampleUs += sampleUs;
+      }
+    }
+    if (now >= endUs) break;
+    sim.step();
+  }
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+  fprintf(stderr, "rs5sim: %.3f s simulated in %.3f s (%.0fx real time), %lu DMX frames, %lu pixel frames\n",
+          endUs / 1e6, wall, wall > 0 ? endUs / 1e6 / wall : 0.0, (unsigned long)sim.dmxFrames, (unsigned long)sim.pixelShows);
+  if (replayPath) {
+    fprintf(stderr, "rs5sim: replayed %lu of %lu capture records%s\n", (unsigned long)std::min(capture.next, capture.frames.size()),
+            (unsigned long)capture.frames.size(), capture.console ? " to the console" : "");
+  }
+  if (sim.serialOut && sim.serialOut != stderr && sim.serialOut != stdout) fclose(sim.serialOut);
+  return 0;
+}
@@ -0,0 +1,513 @@
+// ============================================================================
+// File: sim_runtime.cpp
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Host simulator runtime, core scheduler and the mock arduino-pico,
+//              pico SDK, FreeRTOS, NeoPixel and DmxInput back ends
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+
+#include "sim.h"
+
+#include <Adafruit_NeoPixel.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <hardware/flash.h>
+#include <hardware/pwm.h>
+
+#define SIM_STACK_FILL  0xa5
+
+Simulator sim;
+
+//**********************************************************************************
+// Linker symbols the sketch reads. The FS area is real, erased memory so
+// RS5Flash.h can read and program it; the RAM section markers are all at one
+// address so the static RAM report shows zero.
+#define SIM_STR2(x) #x
+#define SIM_STR(x) SIM_STR2(x)
+asm(".pushsection .data\n"
+    ".balign 4096\n"
+    ".globl _FS_start\n"
+    "_FS_start:\n"
+    ".fill " SIM_STR(SIM_FS_SIZE) ", 1, 0xff\n"
+    ".globl _FS_end\n"
+    "_FS_end:\n"
+    ".globl __data_start__\n"
+    ".globl __data_end__\n"
+    ".globl __bss_start__\n"
+    ".globl __bss_end__\n"
+    "__data_start__:\n"
+    "__data_end__:\n"
+    "__bss_start__:\n"
+    "__bss_end__:\n"
+    ".popsection\n");
+
+extern uint8_t _FS_start[SIM_FS_SIZE];  // Sized here so writes are in bounds
+
+//**********************************************************************************
+// Scheduler
+Simulator::Simulator() {
+  readCostUs = 2;
+  sliceUs = 100;
+  pixelUs = 30;
+  latchUs = 80;
+  current = -1;
+  eventUs = 0;
+  for (int c = 0; c < SIM_CORES; c++) {
+    core[c].timeUs = 0;
+    core[c].stack = NULL;
+    core[c].setupFn = NULL;
+    core[c].loopFn = NULL;
+  }
+  for (int p = 0; p < SIM_GPIO; p++) {
+    inputLevel[p] = HIGH;  // Dip switches open, pulled up
+    outputLevel[p] = LOW;
+    analogValue[p] = 0;
+    pwmFunction[p] = false;
+    pulseNow[p] = 0;
+    pulseSampled[p] = 0;
+  }
+  memset(slice, 0, sizeof(slice));
+  pixelsSampled.n = 0;
+  memset(pixelsSampled.color, 0, sizeof(pixelsSampled.color));
+  pixelShows = 0;
+  dmx = NULL;
+  dmxFrames = 0;
+  serialOut = stderr;
+  randomState = 1;
+  adcRunning = false;
+  adcInput = 0;
+  adcDiv = 0;
+  adcPhaseUs = 0;
+  dmaWrite = NULL;
+  dmaRingMask = 0;
+  dmaIndex = 0;
+  dmaCount = 0;
+  dmaClaimed = 0;
+}
+
+void Simulator::entry(int c) {
+  sim.core[c].setupFn();
+  while (true) sim.core[c].loopFn();
+}
+
+void Simulator::boot(void (*setup0)(), void (*loop0)(), void (*setup1)(), void (*loop1)()) {
+  core[0].setupFn = setup0;
+  core[0].loopFn = loop0;
+  core[1].setupFn = setup1;
+  core[1].loopFn = loop1;
+  for (int c = 0; c < SIM_CORES; c++) {
+    core[c].stack = (uint8_t*)malloc(SIM_STACK_SIZE);
+    memset(core[c].stack, SIM_STACK_FILL, SIM_STACK_SIZE);
+    getcontext(&core[c].ctx);
+    core[c].ctx.uc_stack.ss_sp = core[c].stack;
+    core[c].ctx.uc_stack.ss_size = SIM_STACK_SIZE;
+    core[c].ctx.uc_link = NULL;
+    makecontext(&core[c].ctx, (void (*)())Simulator::entry, 1, c);
+  }
+}
+
+uint64_t Simulator::now() {
+  return core[0].timeUs < core[1].timeUs ? core[0].timeUs : core[1].timeUs;
+}
+
+// Resume the core furthest behind, core 0 first on a tie
+void Simulator::step() {
+  current = core[1].timeUs < core[0].timeUs ? 1 : 0;
+  swapcontext(&mainCtx, &core[current].ctx);
+  current = -1;
+}
+
+void Simulator::yield() {
+  swapcontext(&core[current].ctx, &mainCtx);
+}
+
+uint32_t Simulator::timeUs() {
+  if (current < 0) return eventUs;
+  uint32_t t = core[current].timeUs;
+  charge(readCostUs);
+  return t;
+}
+
+void Simulator::charge(uint32_t us) {
+  if (current < 0) return;
+  core[current].timeUs += us;
+  if (core[current].timeUs > core[current ^ 1].timeUs + sliceUs) yield();
+}
+
+// Bytes at the bottom of the coroutine stack never written
+uint32_t Simulator::stackFree(int c) {
+  uint32_t n = 0;
+  while (n < SIM_STACK_SIZE && core[c].stack[n] == SIM_STACK_FILL) n++;
+  return n;
+}
+
+//**********************************************************************************
+// Driver side inputs
+void Simulator::setInput(int pin, int level) {
+  if (pin >= 0 && pin < SIM_GPIO) inputLevel[pin] = level ? HIGH : LOW;
+}
+
+void Simulator::setAnalog(int pin, int value) {
+  if (pin >= 0 && pin < SIM_GPIO) analogValue[pin] = value;
+}
+
+// Conversions up to us, each one the 10 bit analog value scaled to 12 bits
+// and written by the DMA channel while it has transfers left
+void Simulator::adcConvert(uint64_t us) {
+  double periodUs = (adcDiv + 1) * 1e6 / SIM_ADC_CLK_HZ;
+  if (!adcRunning) {
+    adcPhaseUs = us;
+    return;
+  }
+  while (adcPhaseUs <= us) {
+    adcPhaseUs += periodUs;
+    if (dmaWrite == NULL || dmaCount == 0) continue;
+    int v = analogValue[26 + adcInput] << 2;
+    dmaWrite[dmaIndex] = v > 4095 ? 4095 : v;
+    dmaIndex = dmaRingMask ? (dmaIndex + 1) & dmaRingMask : dmaIndex + 1;
+    dmaCount--;
+  }
+}
+
+void Simulator::typeSerial(const char* s) {
+  while (*s) serialIn.push_back(*s++);
+}
+
+// A complete frame off the wire at time us, data[0] is the start code. Runs
+// like the DmxInput DMA interrupt, between core slices.
+void Simulator::dmxFrame(uint64_t us, const uint8_t* data, int len) {
+  if (dmx == NULL || dmx->buffer == NULL) return;
+  int n = dmx->startChannel + dmx->numChannels;
+  for (int i = 0; i <= n && i < len; i++) {
+    if (i == 0 || i >= (int)dmx->startChannel) dmx->buffer[i] = data[i];
+  }
+  dmx->lastPacketMs = us / 1000;
+  dmxFrames++;
+  eventUs = us;
+  if (dmx->callback) dmx->callback(dmx);
+}
+
+//**********************************************************************************
+// Output history, sampled by the driver once every core is past the sample time
+float Simulator::pulseAt(int gpio, uint64_t us) {
+  std::deque<SimChange<float> >& log = pulseLog[gpio];
+  while (!log.empty() && log.front().timeUs <= us) {
+    pulseSampled[gpio] = log.front().value;
+    log.pop_front();
+  }
+  return pulseSampled[gpio];
+}
+
+const SimPixels& Simulator::pixelsAt(uint64_t us) {
+  while (!pixelLog.empty() && pixelLog.front().timeUs <= us) {
+    pixelsSampled = pixelLog.front().value;
+    pixelLog.pop_front();
+  }
+  return pixelsSampled;
+}
+
+// Recompute the pulse on both pins of a slice
+void Simulator::pwmChanged(uint s) {
+  uint64_t t = current < 0 ? eventUs : core[current].timeUs;
+  for (int gpio = 0; gpio < SIM_GPIO; gpio++) {
+    if (pwm_gpio_to_slice_num(gpio) != s) continue;
+    SimSlice& sl = slice[s];
+    float us = 0;
+    if (pwmFunction[gpio] && sl.enabled) {
+      uint32_t level = sl.level[pwm_gpio_to_channel(gpio)];
+      if (level > sl.top + 1) level = sl.top + 1;
+      us = level * (sl.div / 16.0f) * 1000000.0f / SIM_CLK_HZ;
+    }
+    if (us != pulseNow[gpio]) {
+      pulseNow[gpio] = us;
+      pulseLog[gpio].push_back({ t, us });
+    }
+  }
+}
+
+void Simulator::pixelsShown(const uint32_t* color, uint16_t n) {
+  SimChange<SimPixels> c;
+  c.timeUs = current < 0 ? eventUs : core[current].timeUs;
+  c.value.n = n < SIM_PIXELS ? n : SIM_PIXELS;
+  memcpy(c.value.color, color, c.value.n * sizeof(uint32_t));
+  pixelLog.push_back(c);
+  pixelShows++;
+  charge(n * pixelUs + latchUs);
+}
+
+//**********************************************************************************
+// arduino-pico core
+uint32_t hostTimeUs() {
+  return sim.timeUs();
+}
+
+void hostClockSet(uint32_t us) {
+  if (sim.current >= 0) sim.core[sim.current].timeUs = us;
+}
+
+void hostClockAdvance(uint32_t us) {
+  sim.charge(us);
+}
+
+int hostCoreNum() {
+  return sim.current < 0 ? 0 : sim.current;  // Driver callbacks stand in for core 0 interrupts
+}
+
+void pinMode(int pin, int mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(int pin, int value) {
+  if (pin >= 0 && pin < SIM_GPIO) sim.outputLevel[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(int pin) {
+  return pin >= 0 && pin < SIM_GPIO ? sim.inputLevel[pin] : LOW;
+}
+
+int analogRead(int pin) {
+  return pin >= 0 && pin < SIM_GPIO ? sim.analogValue[pin] : 0;
+}
+
+void analogReadResolution(int bits) {
+  (void)bits;
+}
+
+// xorshift32, repeatable from run to run
+long random(long high) {
+  if (high <= 0) return 0;
+  uint32_t x = sim.randomState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  sim.randomState = x;
+  return x % high;
+}
+
+long random(long low, long high) {
+  if (low >= high) return low;
+  return low + random(high - low);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) sim.randomState = seed;
+}
+
+void hostSerialWrite(const uint8_t* data, size_t len) {
+  if (sim.serialOut) fwrite(data, 1, len, sim.serialOut);
+}
+
+int hostSerialAvailable() {
+  return sim.serialIn.size();
+}
+
+int hostSerialRead() {
+  if (sim.serialIn.empty()) return -1;
+  int c = sim.serialIn.front();
+  sim.serialIn.pop_front();
+  return c;
+}
+
+//**********************************************************************************
+// FreeRTOS, only what the sketch calls
+class SimMutex {
+public:
+  int owner;  // Core, -1 when free
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  SimMutex* m = new SimMutex;
+  m->owner = -1;
+  return m;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+  SimMutex* m = (SimMutex*)sem;
+  while (m->owner >= 0) {
+    if (ticks == 0) return pdFALSE;
+    ticks--;
+    sim.charge(1000);
+  }
+  m->owner = sim.current < 0 ? 0 : sim.current;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  ((SimMutex*)sem)->owner = -1;
+  return pdTRUE;
+}
+
+// Accepted but never scheduled, the handle only has to be unique
+BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param, UBaseType_t priority, TaskHandle_t* handle) {
+  (void)code;
+  (void)name;
+  (void)param;
+  (void)priority;
+  if (handle) *handle = malloc(stackDepth);
+  return pdPASS;
+}
+
+BaseType_t xTaskCreateAffinitySet(TaskFunction_t code, const char* name, uint32_t stackDepth, void* param, UBaseType_t priority,
+                                  UBaseType_t mask, TaskHandle_t* handle) {
+  (void)mask;
+  return xTaskCreate(code, name, stackDepth, param, priority, handle);
+}
+
+void vTaskCoreAffinitySet(TaskHandle_t task, UBaseType_t mask) {
+  (void)task;
+  (void)mask;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  sim.charge(ticks * 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return &sim.core[sim.current < 0 ? 0 : sim.current];
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  for (int c = 0; c < SIM_CORES; c++) {
+    if (task == &sim.core[c]) return sim.stackFree(c) / sizeof(StackType_t);
+  }
+  return configMINIMAL_STACK_SIZE;
+}
+
+//**********************************************************************************
+// pico SDK PWM and flash
+void gpio_set_function(uint gpio, int fn) {
+  if (gpio >= SIM_GPIO) return;
+  sim.pwmFunction[gpio] = fn == GPIO_FUNC_PWM;
+  sim.pwmChanged(pwm_gpio_to_slice_num(gpio));
+}
+
+void pwm_init(uint s, pwm_config* c, bool start) {
+  sim.slice[s].top = c->top;
+  sim.slice[s].div = c->div;
+  sim.slice[s].level[0] = 0;
+  sim.slice[s].level[1] = 0;
+  sim.slice[s].enabled = start;
+  sim.pwmChanged(s);
+}
+
+void pwm_set_wrap(uint s, uint16_t wrap) {
+  sim.slice[s].top = wrap;
+  sim.pwmChanged(s);
+}
+
+void pwm_set_phase_correct(uint s, bool phaseCorrect) {
+  (void)s;
+  (void)phaseCorrect;
+}
+
+void pwm_set_chan_level(uint s, uint chan, uint16_t level) {
+  sim.slice[s].level[chan & 1] = level;
+  sim.pwmChanged(s);
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+  pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_enabled(uint s, bool enabled) {
+  sim.slice[s].enabled = enabled;
+  sim.pwmChanged(s);
+}
+
+//**********************************************************************************
+// pico SDK ADC and DMA, only the free running ADC to memory path
+adc_hw_t simAdcHw;
+
+void adc_init() {
+  sim.adcRunning = false;
+}
+
+void adc_gpio_init(uint gpio) {
+  (void)gpio;
+}
+
+void adc_select_input(uint input) {
+  sim.adcInput = input & 3;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+  (void)en;
+  (void)dreq_en;
+  (void)dreq_thresh;
+  (void)err_in_fifo;
+  (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+  sim.adcDiv = clkdiv;
+}
+
+void adc_run(bool run) {
+  sim.adcRunning = run;
+}
+
+void adc_fifo_drain() {
+}
+
+int dma_claim_unused_channel(bool required) {
+  (void)required;
+  return sim.dmaClaimed++;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr, const volatile void* read_addr,
+                           uint32_t transfer_count, bool trigger) {
+  (void)channel;
+  (void)read_addr;
+  (void)trigger;
+  sim.dmaWrite = (volatile uint16_t*)write_addr;
+  sim.dmaRingMask = config->ringBits ? (1u << config->ringBits) / sizeof(uint16_t) - 1 : 0;
+  sim.dmaIndex = 0;
+  sim.dmaCount = transfer_count;
+}
+
+bool dma_channel_is_busy(uint channel) {
+  (void)channel;
+  return sim.dmaCount > 0;
+}
+
+// Offsets are from the start of flash, the FS area starts where RS5Flash.h
+// computes it from _FS_start
+static uint8_t* simFlashAddr(uint32_t offs, size_t count) {
+  uint32_t fs = (uint32_t)(uintptr_t)(_FS_start - (uint8_t*)XIP_BASE);
+  uint32_t rel = offs - fs;
+  if (rel > SIM_FS_SIZE || count > SIM_FS_SIZE - rel) return NULL;
+  return _FS_start + rel;
+}
+
+// Typical W25Q16 times, charged to the calling core
+static const uint32_t simFlashEraseUs = 45000;  // Per sector
+static const uint32_t simFlashProgramUs = 400;  // Per page
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+  uint8_t* p = simFlashAddr(flash_offs, count);
+  if (p) memset(p, 0xff, count);
+  sim.charge(count / FLASH_SECTOR_SIZE * simFlashEraseUs);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count) {
+  uint8_t* p = simFlashAddr(flash_offs, count);
+  if (p == NULL) return;
+  for (size_t i = 0; i < count; i++) p[i] &= data[i];  // Programming only clears bits
+  sim.charge(count / FLASH_PAGE_SIZE * simFlashProgramUs);
+}
+
+//**********************************************************************************
+// Libraries
+void hostPixelsShow(const uint32_t* color, uint16_t n, uint8_t brightness) {
+  (void)brightness;
+  sim.pixelsShown(color, n);
+}
+
+void hostDmxAttach(DmxInput* input) {
+  sim.dmx = input;
+}
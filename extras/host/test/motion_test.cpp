@@ -0,0 +1,562 @@
+// ============================================================================
+// File: motion_test.cpp
+// Project: SkullMasterV2 - DMX512 Animatronic Controller
+// Version: 3.1.0-alpha
+// Date: 2026-10-18
+// Author: Rose&Swan Productions / Tim Rosener
+// Description: Regression suite for Derivs_Limiter, randomized invariant
+//              checks and golden trajectories of the RS5Hardware.h axes
+// License: CC BY-NC 4.0 (Non-Commercial)
+// ============================================================================
+//
+// Usage:
+//   motion_test invariants                       1M sequences on all host cores
+//   motion_test invariants --sequences 20000 --threads 4 --seed 7
+//   motion_test invariants --seed 7 --trace 1234 sequence 1234 as CSV
+//   motion_test golden --dir test/golden         compare with stored trajectories
+//   motion_test golden --dir test/golden --update
+//
+// invariants replays random target sequences the way loop1() drives the
+// limiter: setTarget() then calc() on a jittery tick, targets changed at
+// random, sometimes mid move. Every tick is checked against
+//
+//   velocity      |vel| <= velLimit
+//   accel         |dvel/dt| <= max(accelLimit, decelLimit * maxStoppingDecel),
+//                 except for the tick that stops on the target
+//   overshoot     a move never passes its target by more than tick jitter
+//                 explains. Started mid move inside the stopping distance it
+//                 may also pass by what braking at decelLimit *
+//                 maxStoppingDecel can't absorb
+//   convergence   a move started at rest settles no later than the time
+//                 optimal trapezoid plus a few ticks, and no earlier than
+//                 the trapezoid at decelLimit * maxStoppingDecel allows
+//   settled       once at the target it stays there, velocity 0
+//
+// The allowances are worked out next to each check in runSequence(). The
+// report lists the worst ratio to each bound seen, failures or not.
+//
+// Sequence n is seeded from (seed, n) alone, so a failure is reproduced with
+// --seed and --trace whatever the thread count.
+//
+// golden runs one fixed DMX cue per axis (jaw, yaw, pitch, roll, eye) on a
+// fixed jittery tick and compares position and velocity every 10ms with
+// test/golden/<axis>.csv. Built with -ffp-contract=off so the float math, and
+// so the files, are the same on every host. After an intended change to the
+// motion, rerun with --update and commit the new files with it.
+
+#include <Arduino.h>
+#include "ServoEngine.h"
+#include "RS5Hardware.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//**********************************************************************************
+// Axes from RS5Hardware.h
+struct Axis {
+  const char* name;
+  float vel, acc, dec;
+  float minDeg, maxDeg, start;
+};
+
+static const Axis axes[] = {
+  { "jaw", JAW_SERVO_MAXVEL, JAW_SERVO_MAXACC, JAW_SERVO_MAXDEC, JAW_SERVO_MINDEG, JAW_SERVO_MAXDEG, JAW_START_POS },
+  { "yaw", YAW_SERVO_MAXVEL, YAW_SERVO_MAXACC, YAW_SERVO_MAXDEC, YAW_SERVO_MINDEG, YAW_SERVO_MAXDEG, YAW_START_POS },
+  { "pitch", PITCH_SERVO_MAXVEL, PITCH_SERVO_MAXACC, PITCH_SERVO_MAXDEC, PITCH_SERVO_MINDEG, PITCH_SERVO_MAXDEG, PITCH_START_POS },
+  { "roll", ROLL_SERVO_MAXVEL, ROLL_SERVO_MAXACC, ROLL_SERVO_MAXDEC, ROLL_SERVO_MINDEG, ROLL_SERVO_MAXDEG, ROLL_START_POS },
+  { "eye", EYE_SERVO_MAXVEL, EYE_SERVO_MAXACC, EYE_SERVO_MAXDEC, EYE_SERVO_MINDEG, EYE_SERVO_MAXDEG, EYE_START_POS },
+};
+#define AXIS_COUNT (sizeof(axes) / sizeof(axes[0]))
+
+// Same mapping readDMX() uses
+static float floatMap(float x, float in_min, float in_max, float out_min, float out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+static Derivs_Limiter makeLimiter(float vel, float acc, float dec, float pos, float stop) {
+  return Derivs_Limiter(vel, acc, dec, pos, pos, 0, false, false, -INFINITY, INFINITY, stop);
+}
+
+// splitmix64, the sequence seed from (seed, index)
+static uint64_t mix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+class Rng {
+public:
+  uint64_t state;
+
+  Rng(uint64_t seed) {
+    state = mix(seed) | 1;
+  }
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state >> 32;
+  }
+  float uniform(float lo, float hi) {
+    return lo + (hi - lo) * (next() / 4294967296.0f);
+  }
+  float logUniform(float lo, float hi) {
+    return lo * powf(hi / lo, next() / 4294967296.0f);
+  }
+  uint32_t below(uint32_t n) {
+    return (uint64_t)next() * n >> 32;
+  }
+};
+
+//**********************************************************************************
+// Invariants
+
+// Time optimal rest to rest move: accelerate, cruise, decelerate
+static float trapezoidTime(float dist, float vel, float acc, float dec) {
+  float ramps = sq(vel) / 2 / acc + sq(vel) / 2 / dec;
+  if (dist >= ramps) return dist / vel + vel / 2 / acc + vel / 2 / dec;
+  float peak = sqrtf(2 * dist * acc * dec / (acc + dec));
+  return peak / acc + peak / dec;
+}
+
+enum Check {
+  CheckVelocity,
+  CheckAccel,
+  CheckOvershootRest,
+  CheckOvershootMoving,
+  CheckLate,
+  CheckEarly,
+  CheckSettled,
+  CheckCount
+};
+
+static const char* checkNames[CheckCount] = { "velocity", "accel", "overshoot (rest)", "overshoot (moving)", "convergence late", "convergence early", "settled" };
+
+// Observed margins are kept as ratio to the allowed value, so the report shows
+// how close the engine runs to each bound
+class Stats {
+public:
+  uint64_t sequences, moves, ticks, timed;
+  uint64_t fails[CheckCount];
+  int64_t firstFail[CheckCount];
+  double worst[CheckCount];
+  std::string firstText[CheckCount];
+  uint32_t moveFailed;  // Checks already failed in this move, counted once
+
+  Stats() {
+    moveFailed = 0;
+    sequences = moves = ticks = timed = 0;
+    for (int c = 0; c < CheckCount; c++) {
+      fails[c] = 0;
+      firstFail[c] = -1;
+      worst[c] = 0;
+    }
+  }
+
+  void observe(Check c, double ratio) {
+    if (ratio > worst[c]) worst[c] = ratio;
+  }
+
+  void fail(Check c, uint64_t seq, const char* fmt, ...) {
+    if (moveFailed & (1 << c)) return;
+    moveFailed |= 1 << c;
+    fails[c]++;
+    if (firstFail[c] >= 0 && (uint64_t)firstFail[c] <= seq) return;
+    char text[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(text, sizeof(text), fmt, ap);
+    va_end(ap);
+    firstFail[c] = seq;
+    firstText[c] = text;
+  }
+
+  void merge(const Stats& o) {
+    sequences += o.sequences;
+    moves += o.moves;
+    ticks += o.ticks;
+    timed += o.timed;
+    for (int c = 0; c < CheckCount; c++) {
+      fails[c] += o.fails[c];
+      worst[c] = std::max(worst[c], o.worst[c]);
+      if (o.firstFail[c] >= 0 && (firstFail[c] < 0 || o.firstFail[c] < firstFail[c])) {
+        firstFail[c] = o.firstFail[c];
+        firstText[c] = o.firstText[c];
+      }
+    }
+  }
+};
+
+static void runSequence(uint64_t seed, uint64_t seq, Stats& st, FILE* trace) {
+  Rng rng(seed * 0x100000001B3ull + seq);
+
+  // Half the sequences use a real axis, half random limits over 0..180
+  float vel, acc, dec, stop, lo, hi;
+  if (rng.below(2)) {
+    const Axis& a = axes[rng.below(AXIS_COUNT)];
+    vel = a.vel;
+    acc = a.acc;
+    dec = a.dec;
+    stop = 2;
+    lo = a.minDeg;
+    hi = a.maxDeg;
+  } else {
+    static const float stops[] = { 1.5f, 2, 3, 4 };
+    vel = rng.logUniform(10, 1000);
+    acc = rng.logUniform(50, 20000);
+    dec = rng.logUniform(50, 20000);
+    stop = stops[rng.below(4)];
+    lo = 0;
+    hi = 180;
+  }
+  float aMax = std::max(acc, dec * stop);
+
+  // loop1() runs on an unpaced but jittery tick
+  uint32_t tickBase = rng.logUniform(20, 1000);
+  uint32_t tickMin = tickBase / 2;
+  uint32_t tickMax = tickMin + tickBase;
+
+  float pos = rng.uniform(lo, hi);
+  Derivs_Limiter dl = makeLimiter(vel, acc, dec, pos, stop);
+  hostClockSet(1000000 + rng.below(1000000));
+  dl.calc();
+
+  if (trace) fprintf(trace, "# vel %g acc %g dec %g stop %g tick %u..%u\nt_us,target,position,velocity,accel\n", vel, acc, dec, stop, tickMin, tickMax);
+
+  uint32_t moves = 4 + rng.below(9);
+  uint64_t t = 0;
+  uint32_t dtPrev = tickBase;
+  for (uint32_t m = 0; m < moves; m++) {
+    float target;
+    switch (rng.below(4)) {
+      case 0:  target = floatMap(rng.below(256), 0, 255, lo, hi); break;  // DMX step
+      case 1:  target = dl.getTarget() + rng.uniform(-1, 1); break;      // Small hop
+      default: target = rng.uniform(lo, hi); break;
+    }
+    target = constrain(target, lo, hi);
+    uint32_t holdUs = rng.logUniform(5000, 1500000);
+
+    float pos0 = dl.getPosition();
+    float vel0 = dl.getVelocity();
+    bool atRest = vel0 == 0;
+    float dist0 = fabsf(target - pos0);
+    float dir = target >= pos0 ? 1 : -1;
+    float towards = vel0 * dir;
+
+    // The limiter brakes on a prediction that the next tick is as long as
+    // this one, tick jitter can carry it past the target by up to half a
+    // tick of the hardest decel
+    float jitterOver = aMax * sq(tickMax / 1e6f) / 2;
+    float eps = 2e-5f * std::max(1.0f, fabsf(target));
+
+    // Mid move the limiter may not be able to stop short. It brakes at up to
+    // decelLimit * maxStoppingDecel until the target, then at decelLimit
+    // once past it; allow the speed left at the target, plus one tick of travel
+    float overshootAllowed = jitterOver;
+    bool forced = !atRest && towards > 0 && sq(towards) > 2 * dec * stop * dist0;
+    if (forced) overshootAllowed += (sq(towards) - 2 * dec * stop * dist0) / 2 / dec;
+    if (!atRest && towards > 0) overshootAllowed += towards * tickMax / 1e6f;
+
+    // On the tick it comes to rest on the target the limiter drops the speed
+    // it carried in, sized by the tick before to stop in the distance left.
+    // Below one float step per tick the position moves in whole steps rather
+    // than at its velocity, that speed may be dropped too. When it can't stop
+    // short and lands on the target exactly, it stops dead whatever the speed.
+    float ulp = nextafterf(fabsf(target), INFINITY) - fabsf(target);
+    float arrivalDv = std::max(sqrtf(2 * aMax * 4 * ulp), ulp / (tickMin / 1e6f));
+
+    float tFast = trapezoidTime(dist0, vel, acc, dec);
+    float tHard = trapezoidTime(dist0, vel, aMax, dec * stop);
+    // Rounding position += vel * dt over thousands of small steps drifts the
+    // arrival by a fraction of a percent either way
+    float lateUs = tFast * 1.03e6f + 8 * tickMax;
+    float earlyUs = tHard * 0.99e6f - 2 * tickMax;  // Not checked under 0.1 deg, float steps rule there
+
+    bool settled = false;
+    uint64_t settledUs = 0;
+    uint32_t held = 0;
+
+    dl.setTarget(target);
+    st.moves++;
+    st.moveFailed = 0;
+    while (held < holdUs) {
+      uint32_t dt = tickMin + rng.below(tickBase + 1);
+      float vPrev = dl.getVelocity();
+      hostClockAdvance(dt);
+      held += dt;
+      t += dt;
+      dl.setTarget(target);
+      float p = dl.calc();
+      float v = dl.getVelocity();
+      st.ticks++;
+
+      if (trace) fprintf(trace, "%llu,%.6f,%.6f,%.6f,%.3f\n", (unsigned long long)t, target, p, v, dl.getAcceleration());
+
+      float vExcess = fabsf(v) - vel;
+      st.observe(CheckVelocity, fabsf(v) / vel);
+      if (vExcess > 1e-6f * vel + 1e-6f) st.fail(CheckVelocity, seq, "move %u: |vel| %g > %g", m, v, vel);
+
+      bool there = p == target && v == 0;
+      float dv = fabsf(v - vPrev);
+      float dvAllowed = aMax * dt / 1e6f;
+      if (there && !settled) dvAllowed = forced ? INFINITY : std::max(aMax * (dt + dtPrev) / 1e6f, arrivalDv);
+      st.observe(CheckAccel, dv / dvAllowed);
+      if (dv - dvAllowed > 1e-6f * std::max(1.0f, std::max(fabsf(v), fabsf(vPrev)))) st.fail(CheckAccel, seq, "move %u: dvel %g in %u us, %g deg/s^2 > %g", m, v - vPrev, dt, dv / dt * 1e6f, aMax);
+
+      float over = (p - target) * dir;
+      if (atRest) {
+        st.observe(CheckOvershootRest, over / (overshootAllowed + eps));
+        if (over > overshootAllowed + eps) st.fail(CheckOvershootRest, seq, "move %u: %g past target %g from rest", m, over, target);
+      } else {
+        st.observe(CheckOvershootMoving, over / (overshootAllowed + eps));
+        if (over > overshootAllowed + eps) st.fail(CheckOvershootMoving, seq, "move %u: %g past target %g, allowed %g (vel0 %g dist0 %g)", m, over, target, overshootAllowed, vel0, dist0);
+      }
+
+      if (settled && !there) st.fail(CheckSettled, seq, "move %u: left target %g, now %g vel %g", m, target, p, v);
+      if (!settled && there) {
+        settled = true;
+        settledUs = held;
+      }
+      dtPrev = dt;
+    }
+
+    if (atRest && dist0 > 0 && holdUs > lateUs) {
+      st.timed++;
+      st.observe(CheckLate, settledUs / lateUs);
+      if (!settled) st.fail(CheckLate, seq, "move %u: %g deg not settled after %u us, expected %.0f", m, dist0, holdUs, lateUs);
+      else if (settledUs > lateUs) st.fail(CheckLate, seq, "move %u: %g deg settled after %llu us, expected %.0f", m, dist0, (unsigned long long)settledUs, lateUs);
+      if (settled && earlyUs > 0 && dist0 >= 0.1f) {
+        st.observe(CheckEarly, earlyUs / settledUs);
+        if (settledUs < earlyUs) st.fail(CheckEarly, seq, "move %u: %g deg settled after %llu us, possible %.0f", m, dist0, (unsigned long long)settledUs, earlyUs);
+      }
+    }
+  }
+  st.sequences++;
+}
+
+static int invariants(uint64_t sequences, int threads, uint64_t seed, int64_t trace) {
+  if (trace >= 0) {
+    Stats st;
+    runSequence(seed, trace, st, stdout);
+    for (int c = 0; c < CheckCount; c++)
+      if (st.fails[c]) fprintf(stderr, "%s: %s\n", checkNames[c], st.firstText[c].c_str());
+    return 0;
+  }
+
+  printf("Derivs_Limiter invariants, %llu sequences on %d threads, seed %llu\n", (unsigned long long)sequences, threads, (unsigned long long)seed);
+
+  std::atomic<uint64_t> nextSeq(0);
+  std::mutex lock;
+  Stats total;
+  std::vector<std::thread> workers;
+  for (int w = 0; w < threads; w++) {
+    workers.emplace_back([&]() {
+      Stats st;
+      for (;;) {
+        uint64_t first = nextSeq.fetch_add(256);
+        if (first >= sequences) break;
+        uint64_t last = std::min(first + 256, sequences);
+        for (uint64_t s = first; s < last; s++) runSequence(seed, s, st, NULL);
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      total.merge(st);
+    });
+  }
+  for (std::thread& w : workers) w.join();
+
+  printf("%llu moves, %llu timed, %llu ticks\n", (unsigned long long)total.moves, (unsigned long long)total.timed, (unsigned long long)total.ticks);
+  printf("%-20s %10s %10s  %s\n", "check", "failures", "worst", "first failure");
+  bool ok = true;
+  for (int c = 0; c < CheckCount; c++) {
+    printf("%-20s %10llu %10.4f", checkNames[c], (unsigned long long)total.fails[c], total.worst[c]);
+    if (total.fails[c]) {
+      printf("  sequence %lld: %s", (long long)total.firstFail[c], total.firstText[c].c_str());
+      ok = false;
+    }
+    printf("\n");
+  }
+  if (!ok) printf("reproduce with: motion_test invariants --seed %llu --trace <sequence>\n", (unsigned long long)seed);
+  return ok ? 0 : 1;
+}
+
+//**********************************************************************************
+// Golden trajectories
+
+// The cue, DMX values at times. Full travel both ways, a small step, a
+// reversal mid move, then a 44Hz sine like the dmx benchmark profile.
+struct Cue {
+  uint32_t ms;
+  int dmx;  // -1 starts the sine
+};
+
+static const Cue cue[] = {
+  { 100, 255 },
+  { 900, 0 },
+  { 1700, 128 },
+  { 1800, 160 },
+  { 1850, 100 },
+  { 2300, -1 },
+  { 3300, 64 },
+};
+#define GOLDEN_END_MS    4000
+#define GOLDEN_SAMPLE_MS 10
+
+static std::vector<std::string> goldenRun(const Axis& a) {
+  std::vector<std::string> rows;
+  Rng rng(1);
+  Derivs_Limiter dl = makeLimiter(a.vel, a.acc, a.dec, a.start, 2);
+  hostClockSet(1000000);
+  dl.calc();
+
+  float target = a.start;
+  bool sine = false;
+  size_t next = 0;
+  uint64_t t = 0;
+  uint64_t sampleUs = 0;
+  while (t <= GOLDEN_END_MS * 1000ull) {
+    while (next < sizeof(cue) / sizeof(cue[0]) && t >= cue[next].ms * 1000ull) {
+      sine = cue[next].dmx < 0;
+      if (!sine) target = floatMap(cue[next].dmx, 0, 255, a.minDeg, a.maxDeg);
+      next++;
+    }
+    if (sine) {
+      uint32_t frame = t / 22727;
+      uint8_t dmx = 127.5f + 127.5f * sinf(frame * 0.05f);
+      target = floatMap(dmx, 0, 255, a.minDeg, a.maxDeg);
+    }
+
+    uint32_t dt = 150 + rng.below(201);
+    hostClockAdvance(dt);
+    t += dt;
+    dl.setTarget(target);
+    dl.calc();
+
+    if (t >= sampleUs) {
+      char row[96];
+      snprintf(row, sizeof(row), "%llu,%.3f,%.3f,%.2f", (unsigned long long)(sampleUs / 1000), target, dl.getPosition(), dl.getVelocity());
+      rows.push_back(row);
+      sampleUs += GOLDEN_SAMPLE_MS * 1000;
+    }
+  }
+  return rows;
+}
+
+static bool readLines(const std::string& path, std::vector<std::string>& lines) {
+  FILE* f = fopen(path.c_str(), "r");
+  if (!f) return false;
+  char line[256];
+  while (fgets(line, sizeof(line), f)) {
+    line[strcspn(line, "\r\n")] = 0;
+    if (line[0] == '#' || !strncmp(line, "t_ms", 4)) continue;
+    lines.push_back(line);
+  }
+  fclose(f);
+  return true;
+}
+
+// Printed values are compared as numbers, a last digit may round either way
+static bool rowMatches(const std::string& want, const std::string& got) {
+  double w[4], g[4];
+  if (sscanf(want.c_str(), "%lf,%lf,%lf,%lf", &w[0], &w[1], &w[2], &w[3]) != 4) return false;
+  if (sscanf(got.c_str(), "%lf,%lf,%lf,%lf", &g[0], &g[1], &g[2], &g[3]) != 4) return false;
+  static const double tol[4] = { 0, 0.002, 0.002, 0.02 };
+  for (int i = 0; i < 4; i++)
+    if (fabs(w[i] - g[i]) > tol[i]) return false;
+  return true;
+}
+
+static int golden(const char* dir, bool update) {
+  bool ok = true;
+  for (const Axis& a : axes) {
+    std::string path = std::string(dir) + "/" + a.name + ".csv";
+    std::vector<std::string> rows = goldenRun(a);
+
+    if (update) {
+      FILE* f = fopen(path.c_str(), "w");
+      if (!f) {
+        fprintf(stderr, "cannot write %s\n", path.c_str());
+        return 2;
+      }
+      fprintf(f, "# %s: vel %g acc %g dec %g, %g..%g deg, start %g\n", a.name, a.vel, a.acc, a.dec, a.minDeg, a.maxDeg, a.start);
+      fprintf(f, "t_ms,target,position,velocity\n");
+      for (const std::string& r : rows) fprintf(f, "%s\n", r.c_str());
+      fclose(f);
+      printf("%-6s %zu samples written to %s\n", a.name, rows.size(), path.c_str());
+      continue;
+    }
+
+    std::vector<std::string> want;
+    if (!readLines(path, want)) {
+      printf("%-6s FAIL cannot read %s\n", a.name, path.c_str());
+      ok = false;
+      continue;
+    }
+    size_t bad = 0, firstBad = 0;
+    for (size_t i = 0; i < std::max(want.size(), rows.size()); i++) {
+      if (i < want.size() && i < rows.size() && rowMatches(want[i], rows[i])) continue;
+      if (bad++ == 0) firstBad = i;
+    }
+    if (bad == 0) {
+      printf("%-6s ok   %zu samples\n", a.name, rows.size());
+    } else {
+      printf("%-6s FAIL %zu of %zu samples differ, first:\n", a.name, bad, std::max(want.size(), rows.size()));
+      printf("       want %s\n", firstBad < want.size() ? want[firstBad].c_str() : "(none)");
+      printf("       got  %s\n", firstBad < rows.size() ? rows[firstBad].c_str() : "(none)");
+      ok = false;
+    }
+  }
+  return ok ? 0 : 1;
+}
+
+//**********************************************************************************
+static void usage() {
+  fprintf(stderr, "usage: motion_test invariants [--sequences n] [--threads n] [--seed n] [--trace sequence]\n"
+                  "       motion_test golden --dir path [--update]\n");
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    usage();
+    return 2;
+  }
+  const char* mode = argv[1];
+  uint64_t sequences = 1000000;
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  uint64_t seed = 1;
+  int64_t trace = -1;
+  const char* dir = NULL;
+  bool update = false;
+
+  for (int a = 2; a < argc; a++) {
+    if (!strcmp(argv[a], "--update")) {
+      update = true;
+      continue;
+    }
+    if (a + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    if (!strcmp(argv[a], "--sequences")) sequences = strtoull(argv[++a], NULL, 0);
+    else if (!strcmp(argv[a], "--threads")) threads = atoi(argv[++a]);
+    else if (!strcmp(argv[a], "--seed")) seed = strtoull(argv[++a], NULL, 0);
+    else if (!strcmp(argv[a], "--trace")) trace = strtoll(argv[++a], NULL, 0);
+    else if (!strcmp(argv[a], "--dir")) dir = argv[++a];
+    else {
+      usage();
+      return 2;
+    }
+  }
+
+  if (!strcmp(mode, "invariants") && threads >= 1) return invariants(sequences, threads, seed, trace);
+  if (!strcmp(mode, "golden") && dir) return golden(dir, update);
+  usage();
+  return 2;
+}
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: dmx_capture.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Record, dump and replay DMX show captures (RS5Capture.h)
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   dmx_capture.py record /dev/ttyACM0 show.cap   live, needs pyserial; sends 'x' to start and stop
+#   dmx_capture.py record console.bin show.cap    keep only the capture frames of a raw console log
+#   dmx_capture.py dump show.cap                  CSV: time_us,frames,channel values in patch order
+#   dmx_capture.py replay /dev/ttyACM0 show.cap   play the capture into the firmware
+#
+# A capture file holds the TelemetryCapture frames as the firmware sent them,
+# 0x00 COBS(record) 0x00, so rs5sim --replay reads it as well.
+#
+# replay sends each record at its captured time. The firmware holds them
+# REPLAY_LEAD_US before applying, so host scheduling jitter below that does
+# not reach the show. During gaps longer than a second the patch is resent
+# so the firmware's REPLAY_TIMEOUT_MS doesn't end the replay.
+
+import argparse
+import struct
+import sys
+import time
+
+from telemetry_decode import cobs_decode
+
+HEADER = struct.Struct("<BBHIHH")  # CaptureRecord header, 12 bytes
+TYPE_CAPTURE = 7
+KEY = 0x01
+PATCH = 0x02
+END = 0x04
+KEEPALIVE_S = 1.0
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code = 0
+    for b in data:
+        if b == 0:
+            out[code] = len(out) - code
+            code = len(out)
+            out.append(0)
+        else:
+            out.append(b)
+            if len(out) - code == 0xFF:
+                out[code] = 0xFF
+                code = len(out)
+                out.append(0)
+    out[code] = len(out) - code
+    return bytes(out)
+
+
+def frame(record):
+    return b"\x00" + cobs_encode(record) + b"\x00"
+
+
+def is_port(name):
+    return name.startswith("/dev/") or name.upper().startswith("COM")
+
+
+def records(data):
+    """Capture records in a raw byte stream, console text is skipped"""
+    out = []
+    for raw in data.split(b"\x00"):
+        rec = cobs_decode(raw) if raw else None
+        if not rec or rec[0] != TYPE_CAPTURE or len(rec) < HEADER.size:
+            continue
+        _, flags, _, _, _, mask = HEADER.unpack_from(rec)
+        n = bin(mask).count("1")
+        if len(rec) == HEADER.size + (2 * n if flags & PATCH else n):
+            out.append(rec)
+    return out
+
+
+def record(args):
+    if is_port(args.source):
+        import serial
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        port.write(b"x")
+        data = bytearray()
+        print("recording, ctrl-c to stop", file=sys.stderr)
+        try:
+            while True:
+                data += port.read(4096)
+        except KeyboardInterrupt:
+            port.write(b"x")
+            data += port.read(4096)
+    else:
+        with open(args.source, "rb") as f:
+            data = f.read()
+    recs = records(bytes(data))
+    with open(args.output, "wb") as f:
+        for rec in recs:
+            f.write(frame(rec))
+    print("%d capture records" % len(recs), file=sys.stderr)
+
+
+def dump(args):
+    with open(args.capture, "rb") as f:
+        recs = records(f.read())
+    patch = []
+    values = {}
+    for rec in recs:
+        _, flags, seq, time_us, frames, mask = HEADER.unpack_from(rec)
+        bits = [k for k in range(16) if mask & (1 << k)]
+        if flags & PATCH:
+            patch = list(struct.unpack_from("<%dH" % len(bits), rec, HEADER.size))
+            print("# patch " + " ".join(str(c) for c in patch))
+            print("time_us,frames," + ",".join("ch%d" % c for c in patch))
+            continue
+        for i, k in enumerate(bits):
+            if k < len(patch):
+                values[patch[k]] = rec[HEADER.size + i]
+        print(",".join(str(x) for x in [time_us, frames] + [values.get(c, "") for c in patch]))
+
+
+def replay(args):
+    import serial
+    with open(args.capture, "rb") as f:
+        recs = records(f.read())
+    while recs and not HEADER.unpack_from(recs[0])[1] & PATCH:
+        recs.pop(0)  # The firmware needs the patch first
+    if not recs:
+        sys.exit("no capture records in %s" % args.capture)
+    port = serial.Serial(args.port, args.baud, timeout=0)
+    first = HEADER.unpack_from(recs[0])[3]
+    patch = recs[0]
+    start = time.monotonic()
+    sent = time.monotonic()
+    for rec in recs:
+        _, flags, _, time_us, _, _ = HEADER.unpack_from(rec)
+        if flags & PATCH:
+            patch = rec
+        due = start + ((time_us - first) & 0xFFFFFFFF) / 1e6
+        while time.monotonic() < due:
+            if time.monotonic() - sent > KEEPALIVE_S:
+                port.write(frame(patch))
+                sent = time.monotonic()
+            port.read(4096)  # Keep the firmware's console output flowing
+            time.sleep(min(0.002, max(0.0, due - time.monotonic())))
+        port.write(frame(rec))
+        sent = time.monotonic()
+    port.write(frame(HEADER.pack(TYPE_CAPTURE, END, 0, 0, 0, 0)))
+    print("%d capture records sent in %.1f s" % (len(recs), time.monotonic() - start), file=sys.stderr)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("--baud", type=int, default=115200)
+    sub = ap.add_subparsers(dest="command", required=True)
+    p = sub.add_parser("record", help="record from a port or filter a raw console log")
+    p.add_argument("source")
+    p.add_argument("output")
+    p.set_defaults(run=record)
+    p = sub.add_parser("dump", help="print a capture as CSV")
+    p.add_argument("capture")
+    p.set_defaults(run=dump)
+    p = sub.add_parser("replay", help="play a capture into the firmware")
+    p.add_argument("port")
+    p.add_argument("capture")
+    p.set_defaults(run=replay)
+    args = ap.parse_args()
+    args.run(args)
+
+
+if __name__ == "__main__":
+    main()
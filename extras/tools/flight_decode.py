@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: flight_decode.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Fetch and decode a motion flight recorder dump (RS5Recorder.h)
+#              into CSV, one row per sample and axis
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   flight_decode.py /dev/ttyACM0 > flight.csv    sends 'w' and reads the dump, needs pyserial
+#   flight_decode.py dump.bin > flight.csv        decode a raw capture
+#
+# Columns: t_ms (relative to the trigger), axis, target, pos, vel, acc, duty
+
+import argparse
+import struct
+import sys
+
+from telemetry_decode import cobs_decode
+
+HEADER = struct.Struct("<IBBBBHHI")
+MAGIC = 0x46355352
+AXIS = struct.Struct("<hhhhH")
+TRIGGERS = ["none", "dmx loss", "limit", "serial", "stall"]
+
+
+def frames(data):
+    for chunk in data.split(b"\x00"):
+        if chunk:
+            raw = cobs_decode(chunk)
+            if raw is not None:
+                yield raw
+
+
+def decode(data, out):
+    header = None
+    samples = []
+    for raw in frames(data):
+        if header is None:
+            if len(raw) == HEADER.size and HEADER.unpack(raw)[0] == MAGIC:
+                header = HEADER.unpack(raw)
+            continue
+        axes = header[2]
+        if len(raw) == 4 + AXIS.size * axes:
+            samples.append(raw)
+    if header is None:
+        raise SystemExit("no recorder header found")
+
+    magic, version, axes, trigger, mask, count, trigger_frame, period_us = header
+    reason = TRIGGERS[trigger] if trigger < len(TRIGGERS) else str(trigger)
+    print("recorder v%d: %d of %d samples, %d us period, trigger %s at sample %d"
+          % (version, len(samples), count, period_us, reason, trigger_frame), file=sys.stderr)
+
+    t0 = struct.unpack_from("<I", samples[trigger_frame])[0] if trigger_frame < len(samples) else 0
+    out.write("t_ms,axis,target,pos,vel,acc,duty\n")
+    for raw in samples:
+        t = (struct.unpack_from("<I", raw)[0] - t0) & 0xFFFFFFFF
+        if t & 0x80000000:
+            t -= 1 << 32
+        for a in range(axes):
+            if not mask & (1 << a):
+                continue
+            target, pos, vel, acc, duty = AXIS.unpack_from(raw, 4 + a * AXIS.size)
+            out.write("%.3f,%d,%.1f,%.1f,%.1f,%d,%.2f\n" % (t / 1000, a, target / 10, pos / 10, vel / 10, acc, duty / 100))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode a flight recorder dump")
+    ap.add_argument("source", help="serial port or capture file")
+    ap.add_argument("--baud", type=int, default=115200)
+    args = ap.parse_args()
+
+    if args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+        import serial
+        port = serial.Serial(args.source, args.baud, timeout=1.0)
+        port.reset_input_buffer()
+        port.write(b"w")
+        data = bytearray()
+        while True:
+            chunk = port.read(65536)
+            if not chunk:
+                break  # dump finished, the port went quiet
+            data += chunk
+    else:
+        with open(args.source, "rb") as f:
+            data = f.read()
+    decode(bytes(data), sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
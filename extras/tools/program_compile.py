@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: program_compile.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Compile a choreography text file into the flash program format
+#              of RS5Program.h, or list a compiled program
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   program_compile.py show.txt show.rs5p        compile
+#   program_compile.py --dump show.rs5p          list the events of a program
+#
+# --dump lists a teach-in take (RS5Teach.h) as step events, one per changed
+# track and frame, so a take can be edited and compiled back.
+#
+# Source, one statement per line, # starts a comment:
+#   duration 12000                 length of one pass in ms (default: last event)
+#   loop                           start over after each pass
+#   0     jaw     0                time ms, track, DMX level: step
+#   500   jaw     255  300 ease    ramp over 300ms, curve linear (default),
+#                                  ease, easein or easeout
+#   0     preset  128              eye preset channel value, always a step
+#
+# Tracks are jaw, yaw, pitch, roll, eye (servo axes 0-4) and preset, or a
+# track number. Flash the result at FLASH_PROGRAM_OFFSET of the FS area, e.g.
+#   picotool load -o <FS start + 0x1000> show.rs5p
+# where the FS start follows the Flash Size option of the build.
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x50355352
+VERSION = 1
+FLAG_LOOP = 0x01
+FLAG_FRAMES = 0x02
+HEADER = struct.Struct("<IHHIII")
+TRACKS = {"jaw": 0, "yaw": 1, "pitch": 2, "roll": 3, "eye": 4, "preset": 5}
+CURVES = {"step": 0, "linear": 1, "ease": 2, "easein": 3, "easeout": 4}
+TRACK_EYES = 5
+DURATION_MAX = 3600000
+SIZE_MAX = 12 * 4096  # FLASH_PROGRAM_SIZE
+
+
+def varint(v):
+    out = bytearray()
+    while True:
+        b = v & 0x7F
+        v >>= 7
+        if v:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return bytes(out)
+
+
+def read_varint(data, pos):
+    v = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        v |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return v, pos
+        shift += 7
+
+
+def parse(path):
+    events = []
+    duration = 0
+    loop = False
+    with open(path) as f:
+        for num, line in enumerate(f, 1):
+            words = line.split("#")[0].split()
+            if not words:
+                continue
+            try:
+                if words[0] == "duration" and len(words) == 2:
+                    duration = int(words[1])
+                    continue
+                if words[0] == "loop" and len(words) == 1:
+                    loop = True
+                    continue
+                if not 3 <= len(words) <= 5:
+                    raise ValueError("expected: time track level [ramp [curve]]")
+                time_ms = int(float(words[0]))
+                track = TRACKS[words[1]] if words[1] in TRACKS else int(words[1])
+                level = int(words[2])
+                ramp = int(words[3]) if len(words) > 3 else 0
+                curve = CURVES[words[4]] if len(words) > 4 else (CURVES["linear"] if ramp else CURVES["step"])
+                if not 0 <= track <= TRACK_EYES or not 0 <= level <= 255 or time_ms < 0 or ramp < 0:
+                    raise ValueError("track, level, time or ramp out of range")
+                if track == TRACK_EYES or ramp == 0:
+                    curve = CURVES["step"]
+                events.append((time_ms, num, track, curve, level, ramp))
+            except (KeyError, ValueError) as e:
+                sys.exit("%s:%d: %s" % (path, num, e))
+    events.sort()  # By time, then source line
+    if not events:
+        sys.exit("%s: no events" % path)
+    last = events[-1][0]
+    duration = duration or last
+    if duration <= 0 or duration < last or duration > DURATION_MAX:
+        sys.exit("%s: duration %d ms does not cover the last event at %d ms" % (path, duration, last))
+    return events, duration, loop
+
+
+def compile_program(events, duration, loop):
+    body = bytearray()
+    now = 0
+    for time_ms, _, track, curve, level, ramp in events:
+        body += varint(time_ms - now)
+        body.append(track | curve << 4)
+        body.append(level)
+        if curve:
+            body += varint(ramp)
+        now = time_ms
+    head = HEADER.pack(MAGIC, VERSION, FLAG_LOOP if loop else 0, duration, len(body), zlib.crc32(body))
+    return head + bytes(body)
+
+
+def dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, flags, duration, length, crc = HEADER.unpack_from(data)
+    body = data[HEADER.size:HEADER.size + length]
+    ok = magic == MAGIC and version == VERSION and len(body) == length and zlib.crc32(body) == crc
+    print("# %s, %d bytes, crc %s" % ("RS5 program" if magic == MAGIC else "not a program", length, "ok" if ok else "BAD"))
+    print("duration %d" % duration)
+    if flags & FLAG_LOOP:
+        print("loop")
+    names = {v: k for k, v in TRACKS.items()}
+    curves = {v: k for k, v in CURVES.items()}
+    pos = 0
+    now = 0
+    levels = [0] * (TRACK_EYES + 1)
+    while pos < len(body) and flags & FLAG_FRAMES:
+        delta, pos = read_varint(body, pos)
+        mask = body[pos]
+        pos += 1
+        now += delta
+        for track in range(TRACK_EYES + 1):
+            if mask & (1 << track):
+                z, pos = read_varint(body, pos)
+                levels[track] += -(z >> 1) - 1 if z & 1 else z >> 1
+                print("%-7d %-7s %3d" % (now, names[track], levels[track]))
+    while pos < len(body):
+        delta, pos = read_varint(body, pos)
+        track, curve, level = body[pos] & 0x0F, body[pos] >> 4, body[pos + 1]
+        pos += 2
+        now += delta
+        line = "%-7d %-7s %3d" % (now, names.get(track, track), level)
+        if curve:
+            ramp, pos = read_varint(body, pos)
+            line += " %5d %s" % (ramp, curves.get(curve, curve))
+        print(line)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("source", help="choreography text, or a program with --dump")
+    ap.add_argument("output", nargs="?", help="program file to write")
+    ap.add_argument("--dump", action="store_true", help="list a compiled program")
+    args = ap.parse_args()
+    if args.dump:
+        dump(args.source)
+        return
+    if not args.output:
+        ap.error("output file required")
+    events, duration, loop = parse(args.source)
+    program = compile_program(events, duration, loop)
+    if len(program) > SIZE_MAX:
+        sys.exit("program is %d bytes, FLASH_PROGRAM_SIZE is %d" % (len(program), SIZE_MAX))
+    with open(args.output, "wb") as f:
+        f.write(program)
+    print("%d events, %d bytes" % (len(events), len(program)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
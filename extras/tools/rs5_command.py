@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: rs5_command.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Live tuning over the binary command protocol (RS5Command.h),
+#              get and set servo and system settings, save them to flash
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage (needs pyserial):
+#   rs5_command.py /dev/ttyACM0 ping
+#   rs5_command.py /dev/ttyACM0 get 0 maxvel        servo 0
+#   rs5_command.py /dev/ttyACM0 set 0 maxvel 120
+#   rs5_command.py /dev/ttyACM0 get debuglevel      system fields take no servo
+#   rs5_command.py /dev/ttyACM0 set debuglevel 3
+#   rs5_command.py /dev/ttyACM0 dump                every field of every servo
+#   rs5_command.py /dev/ttyACM0 save                tuning into the config store
+#   rs5_command.py /dev/ttyACM0 savepos 1           servo positions into slot 1
+#   rs5_command.py /dev/ttyACM0 recall 1
+#
+# Each request waits for its reply, matched by tag. Busy is retried, other
+# failures print the status and exit 1. Console text and telemetry frames
+# arriving meanwhile are skipped.
+
+import argparse
+import sys
+import time
+
+from dmx_capture import frame
+from telemetry_decode import (COMMAND, COMMAND_OPS, SERVO_FIELDS, SYSTEM_FIELDS, TYPE_COMMAND, cobs_decode,
+                              command_text, field_name)
+
+BUSY = 6
+SERVOS = 6  # NUM_SERVO_PINS
+TIMEOUT_S = 1.0
+RETRIES = 20
+
+
+def field_number(name):
+    if name in SERVO_FIELDS:
+        return SERVO_FIELDS.index(name)
+    if name in SYSTEM_FIELDS:
+        return 0x80 + SYSTEM_FIELDS.index(name)
+    raise SystemExit("unknown field %s, one of %s" % (name, ", ".join(SERVO_FIELDS + SYSTEM_FIELDS)))
+
+
+class Link:
+    def __init__(self, port):
+        self.port = port
+        self.buf = bytearray()
+        self.tag = int(time.time()) & 0x7FFF  # Replies left over from an earlier run don't match
+
+    def reply(self, tag, deadline):
+        while time.monotonic() < deadline:
+            self.buf += self.port.read(256)
+            while b"\x00" in self.buf:
+                end = self.buf.index(b"\x00")
+                raw = cobs_decode(bytes(self.buf[:end])) if end else None
+                del self.buf[:end + 1]
+                if raw and raw[0] == TYPE_COMMAND and len(raw) == COMMAND.size and COMMAND.unpack(raw)[3] == tag:
+                    return raw
+        return None
+
+    def request(self, op, target=0, field=0, value=0.0):
+        for _ in range(RETRIES):
+            self.tag = (self.tag + 1) & 0xFFFF
+            self.port.write(frame(COMMAND.pack(TYPE_COMMAND, op, 0, self.tag, target, field, value, 0)))
+            raw = self.reply(self.tag, time.monotonic() + TIMEOUT_S)
+            if raw is None:
+                raise SystemExit("no reply, is the firmware built with RS5_COMMAND?")
+            if COMMAND.unpack(raw)[7] != BUSY:
+                return raw
+            time.sleep(0.01)
+        return raw
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("port", help="serial port")
+    ap.add_argument("op", choices=COMMAND_OPS + ["dump"])
+    ap.add_argument("args", nargs="*", help="[servo] [field] [value], or a position slot")
+    ap.add_argument("--baud", type=int, default=115200)
+    args = ap.parse_args()
+
+    import serial
+    link = Link(serial.Serial(args.port, args.baud, timeout=0.05))
+    words = list(args.args)
+
+    if args.op == "dump":
+        for servo in range(SERVOS):
+            values = []
+            for field in range(len(SERVO_FIELDS)):
+                raw = link.request(COMMAND_OPS.index("get"), servo, field)
+                values.append("%s %g" % (field_name(field), COMMAND.unpack(raw)[6]))
+            print("servo %d: %s" % (servo, ", ".join(values)))
+        for field in range(len(SYSTEM_FIELDS)):
+            raw = link.request(COMMAND_OPS.index("get"), 0, 0x80 + field)
+            print("%s %g" % (SYSTEM_FIELDS[field], COMMAND.unpack(raw)[6]))
+        return
+
+    op = COMMAND_OPS.index(args.op)
+    target = int(words.pop(0)) if words and words[0].isdigit() else 0
+    field = 0
+    value = 0.0
+    try:
+        if args.op in ("get", "set"):
+            field = field_number(words.pop(0))
+        if args.op == "set":
+            value = float(words.pop(0))
+    except IndexError:
+        ap.error("%s needs %s" % (args.op, "servo, field and value" if args.op == "set" else "a field"))
+    if words:
+        ap.error("unexpected %s" % " ".join(words))
+
+    raw = link.request(op, target, field, value)
+    print(command_text(raw))
+    sys.exit(1 if COMMAND.unpack(raw)[7] else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: rs5_stream.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Stream servo targets to the firmware over USB (RS5Stream.h,
+#              RunModeSerial) from a CSV file or a test sweep
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage (needs pyserial):
+#   rs5_stream.py /dev/ttyACM0 show.csv            play a CSV at its times
+#   rs5_stream.py /dev/ttyACM0 --sweep 10          all axes sweep for 10s
+#   rs5_stream.py /dev/ttyACM0 --sweep 10 --rate 1000
+#
+# CSV rows: t_ms, one level per servo (jaw, yaw, pitch, roll, eye, servo 5)
+# as DMX levels 0-255 with fractions allowed, then optionally an eye preset
+# DMX value. Missing servos stay at level 0. Between rows the levels are
+# interpolated at --rate frames per second. Lines starting with # or a letter
+# are skipped.
+#
+# Every frame carries its time on the host clock, so the firmware plays the
+# timeline and not the USB arrival times. The stream ends with a StreamEnd
+# frame; the firmware's report comes back on the console.
+
+import argparse
+import bisect
+import math
+import struct
+import sys
+import time
+
+from dmx_capture import frame
+
+TYPE_STREAM = 9
+EYES = 0x01
+END = 0x02
+AXES = 6  # NUM_LIC_SERVOS
+RECORD = struct.Struct("<BBHIBB%dH" % AXES)
+
+
+def load_csv(path):
+    rows = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line[0] == "#" or line[0].isalpha():
+                continue
+            v = [float(x) for x in line.split(",")]
+            rows.append(v)
+    if not rows:
+        sys.exit("%s: no rows" % path)
+    return rows
+
+
+def sample(rows, t_ms):
+    """Levels and eye value at t_ms, linear between rows"""
+    times = [r[0] for r in rows]
+    k = bisect.bisect_right(times, t_ms)
+    if k == 0:
+        row = rows[0]
+    elif k >= len(rows):
+        row = rows[-1]
+    else:
+        a, b = rows[k - 1], rows[k]
+        f = (t_ms - a[0]) / (b[0] - a[0]) if b[0] > a[0] else 1.0
+        row = [x + (y - x) * f for x, y in zip(a, b)]
+        if len(a) > 1 + AXES:
+            row[1 + AXES] = a[1 + AXES]  # Eye preset steps, never blends
+    levels = row[1:1 + AXES]
+    eyes = int(row[1 + AXES]) if len(row) > 1 + AXES else None
+    return levels, eyes
+
+
+def record(seq, t_us, levels, eyes, flags=0):
+    lv = [max(0, min(65535, int(round(x * 257)))) for x in levels]
+    lv += [0] * (AXES - len(lv))
+    if eyes is not None:
+        flags |= EYES
+    return RECORD.pack(TYPE_STREAM, flags, seq & 0xFFFF, t_us & 0xFFFFFFFF, eyes or 0, 0, *lv)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("port", help="serial port")
+    ap.add_argument("csv", nargs="?", help="t_ms,levels... file")
+    ap.add_argument("--sweep", type=float, metavar="S", help="sweep all axes for S seconds instead of a CSV")
+    ap.add_argument("--rate", type=float, default=500, help="frames per second (default 500, up to 1000)")
+    ap.add_argument("--baud", type=int, default=115200)
+    args = ap.parse_args()
+    if (args.csv is None) == (args.sweep is None):
+        ap.error("give a CSV file or --sweep")
+
+    if args.csv:
+        rows = load_csv(args.csv)
+        duration = rows[-1][0] / 1000
+    else:
+        duration = args.sweep
+
+    import serial
+    port = serial.Serial(args.port, args.baud, timeout=0)
+    period = 1 / args.rate
+    seq = 0
+    start = time.monotonic()
+    t = 0.0
+    while t <= duration:
+        if args.csv:
+            levels, eyes = sample(rows, t * 1000)
+        else:
+            levels = [127.5 + 127.5 * math.sin(2 * math.pi * t / 4)] * AXES
+            eyes = None
+        port.write(frame(record(seq, int(t * 1e6), levels, eyes)))
+        seq += 1
+        t += period
+        wait = start + t - time.monotonic()
+        if wait > 0:
+            time.sleep(wait)
+        sys.stdout.buffer.write(port.read(4096))  # Console text, the report at the end
+    port.write(frame(record(seq, int(t * 1e6), [], None, END)))
+    deadline = time.monotonic() + 0.5
+    while time.monotonic() < deadline:
+        sys.stdout.buffer.write(port.read(4096))
+        time.sleep(0.05)
+    sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
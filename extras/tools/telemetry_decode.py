@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: telemetry_decode.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Decode the COBS framed binary telemetry stream (RS5Telemetry.h)
+#              from a serial port or a capture file
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   telemetry_decode.py /dev/ttyACM0          live, needs pyserial; sends 't' to start
+#   telemetry_decode.py capture.bin           decode a raw capture
+#   telemetry_decode.py --csv capture.bin     one CSV row per record
+#
+# Deferred trace records (TRACE(), RS5Trace.h) are printed with the format
+# strings from --strings, a table made by trace_strings.py. Without it the
+# sources next to this script are scanned.
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+import trace_strings
+
+RECORD = struct.Struct("<BBHI6h")  # TelemetryRecord, 20 bytes
+TRACE = struct.Struct("<BBHII")    # TraceRecord header, then nargs x uint32
+TYPE_TRACE = 6
+TYPE_CAPTURE = 7                   # DMX capture, decoded by dmx_capture.py
+TYPE_COMMAND = 8
+COMMAND = struct.Struct("<BBHHBBfB3x")  # CommandRecord, 16 bytes (RS5Command.h)
+COMMAND_OPS = ["ping", "get", "set", "save", "savepos", "recall"]
+COMMAND_STATUS = ["ok", "bad op", "bad field", "bad target", "bad value", "read only", "busy", "failed"]
+SERVO_FIELDS = ["licensed", "mindeg", "maxdeg", "maxvel", "maxacc", "maxdec", "smooth", "minpwm", "maxpwm",
+                "sleep", "servomindeg", "servomaxdeg", "freq", "startdeg"]
+SYSTEM_FIELDS = ["debuglevel", "debugservo", "dmxaddress", "runmode", "packetagelimit", "currentbudget", "current"]  # From 0x80
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l)?([diouxXcsfFeEgG%])")
+
+STAGES = ["loop0", "readDMX", "dipSwitches", "renderEyes", "servoMonitor",
+          "loop1", "setServoPositions", "sendPixelFrame", "debugHooks", "program", "teach"]
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def describe(rtype, rid, v):
+    if rtype == 1:
+        flags = ("active " if v[4] & 1 else "") + ("pwm" if v[4] & 2 else "")
+        return "servo %d pos %.1f target %.1f vel %.1f duty %d %s" % (rid, v[0] / 10, v[1] / 10, v[2] / 10, v[3], flags)
+    if rtype == 2:
+        return "config %d deg %d-%d vel %d acc %d dec %d freq %d" % (rid, *v)
+    if rtype == 3:
+        return "dmx start %d addr %d ch %d,%d eyes %d,%d age %dms" % (rid, *v)
+    if rtype == 4:
+        name = STAGES[rid] if rid < len(STAGES) else str(rid)
+        return "loop %-18s n %d min %d avg %d p99<= %d max %d us" % (name, *(x & 0xFFFF for x in v[:5]))
+    if rtype == 5:
+        return "stats dropped core0 %d core1 %d task %d trace %d/%d sent %d" % (v[0], v[1], v[3], v[4], v[5], v[2] & 0xFFFF)
+    return "type %d id %d %s" % (rtype, rid, list(v))
+
+
+def field_name(field):
+    if field < len(SERVO_FIELDS):
+        return SERVO_FIELDS[field]
+    if 0x80 <= field < 0x80 + len(SYSTEM_FIELDS):
+        return SYSTEM_FIELDS[field - 0x80]
+    return "field %d" % field
+
+
+def command_text(raw):
+    """A command reply, tag first so it lines up with the request"""
+    _, op, _, tag, target, field, value, status = COMMAND.unpack(raw)
+    name = COMMAND_OPS[op] if op < len(COMMAND_OPS) else "op %d" % op
+    if op in (1, 2):
+        where = "" if field >= 0x80 else "servo %d " % target
+        text = "%s %s%s %g" % (name, where, field_name(field), value)
+    elif op in (4, 5):
+        text = "%s %d" % (name, target)
+    else:
+        text = "%s %g" % (name, value) if op == 0 else name
+    return "command tag %d %s %s" % (tag, text, COMMAND_STATUS[status] if status < len(COMMAND_STATUS) else status)
+
+
+def trace_text(fmt, raw):
+    """Format raw 32 bit trace arguments, types come from the conversions"""
+    args = []
+    for conv in CONVERSION.findall(fmt):
+        if conv == "%" or not raw:
+            continue
+        v = raw.pop(0)
+        if conv in "fFeEgG":
+            args.append(struct.unpack("<f", struct.pack("<I", v))[0])
+        elif conv in "di":
+            args.append(v - (1 << 32) if v & 0x80000000 else v)
+        elif conv == "s":
+            args.append("<%08x>" % v)
+        else:
+            args.append(v)
+    fmt = re.sub(r"(%[-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l)", r"\1", fmt)
+    try:
+        return (fmt % tuple(args)).rstrip("\n")
+    except (TypeError, ValueError):
+        return "%r %s" % (fmt, args)
+
+
+class Decoder:
+    def __init__(self, csv, strings):
+        self.csv = csv
+        self.strings = strings
+        self.buf = bytearray()
+        self.last_seq = {}
+        self.bad = 0
+        self.captured = 0
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            end = self.buf.find(b"\x00")
+            if end < 0:
+                return
+            frame = bytes(self.buf[:end])
+            del self.buf[:end + 1]
+            if frame:
+                self.frame(frame)
+
+    def frame(self, frame):
+        raw = cobs_decode(frame)
+        if raw and raw[0] == TYPE_TRACE and len(raw) >= TRACE.size:
+            self.trace(raw)
+            return
+        if raw and raw[0] == TYPE_CAPTURE:
+            self.captured += 1
+            return
+        if raw and raw[0] == TYPE_COMMAND and len(raw) == COMMAND.size:
+            rtype, op, seq, tag, target, field, value, status = COMMAND.unpack(raw)
+            if self.csv:  # No time stamp, id is the field
+                print(",".join(str(x) for x in [0, rtype, field, seq, op, tag, target, value, status]))
+                return
+            print("%10s    #%-5d %s" % ("", seq, command_text(raw)))
+            return
+        if raw is None or len(raw) != RECORD.size:
+            self.bad += 1  # console text or a damaged frame
+            return
+        rtype, rid, seq, time_us, *v = RECORD.unpack(raw)
+        if self.csv:
+            print(",".join(str(x) for x in [time_us, rtype, rid, seq] + v))
+            return
+        print("%10.3f ms #%-5d %s" % (time_us / 1000, seq, describe(rtype, rid, v)))
+
+    def trace(self, raw):
+        rtype, nargs, seq, time_us, fid = TRACE.unpack_from(raw)
+        if len(raw) != TRACE.size + 4 * nargs:
+            self.bad += 1
+            return
+        args = list(struct.unpack_from("<%dI" % nargs, raw, TRACE.size))
+        fmt = self.strings.get(fid)
+        if self.csv:
+            print(",".join(str(x) for x in [time_us, rtype, fid, seq] + args))
+            return
+        text = trace_text(fmt, args) if fmt is not None else "trace %08x %s" % (fid, args)
+        print("%10.3f ms #%-5d %s" % (time_us / 1000, seq, text))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("source", help="serial port or capture file")
+    ap.add_argument("--csv", action="store_true", help="print CSV: time_us,type,id,seq,v0..v5")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--strings", help="trace format table from trace_strings.py")
+    args = ap.parse_args()
+
+    if args.strings:
+        with open(args.strings) as f:
+            strings = {int(k, 16): v for k, v in json.load(f).items()}
+    else:
+        strings = trace_strings.scan(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+    dec = Decoder(args.csv, strings)
+    if args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+        import serial
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        port.write(b"t")
+        try:
+            while True:
+                dec.feed(port.read(4096))
+        except KeyboardInterrupt:
+            port.write(b"t")
+    else:
+        with open(args.source, "rb") as f:
+            dec.feed(f.read())
+    if dec.bad:
+        print("skipped %d non telemetry frames" % dec.bad, file=sys.stderr)
+    if dec.captured:
+        print("skipped %d DMX capture records, see dmx_capture.py" % dec.captured, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+# ============================================================================
+# File: trace_strings.py
+# Project: SkullMasterV2 - DMX512 Animatronic Controller
+# Version: 3.1.0-alpha
+# Date: 2026-10-18
+# Author: Rose&Swan Productions / Tim Rosener
+# Description: Extract TRACE() and TRACE_AXIS() format strings (RS5Trace.h) into the side table
+#              telemetry_decode.py uses to rebuild deferred log text
+# License: CC BY-NC 4.0 (Non-Commercial)
+# ============================================================================
+#
+# Usage:
+#   trace_strings.py [source dir] > trace_strings.json
+#
+# Run it against the same sources the firmware was built from. Two formats
+# with the same hash stop the script, change one of the strings.
+
+import glob
+import json
+import os
+import re
+import sys
+
+TRACE_CALL = re.compile(r'\bTRACE(?:_AXIS)?\s*\(\s*\w+\s*,\s*(?:\w+\s*,\s*)?((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+
+def trace_hash(text):
+    """FNV-1a 32 bit, must match traceHash() in RS5Trace.h"""
+    h = 2166136261
+    for b in text.encode("latin-1"):
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def unescape(s):
+    return s.encode("latin-1").decode("unicode_escape")
+
+
+def scan(root):
+    table = {}
+    files = sorted(glob.glob(os.path.join(root, "*.ino")) + glob.glob(os.path.join(root, "*.h")))
+    for path in files:
+        with open(path, encoding="utf-8", errors="replace") as f:
+            src = f.read()
+        for m in TRACE_CALL.finditer(src):
+            line = src[src.rfind("\n", 0, m.start()) + 1:m.start()]
+            if "//" in line:
+                continue  # example in a comment
+            fmt = "".join(unescape(x) for x in LITERAL.findall(m.group(1)))
+            h = trace_hash(fmt)
+            if h in table and table[h] != fmt:
+                raise SystemExit("trace hash collision %08x: %r and %r" % (h, table[h], fmt))
+            table[h] = fmt
+    return table
+
+
+def main():
+    root = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+    table = scan(root)
+    json.dump({"%08x" % k: v for k, v in sorted(table.items())}, sys.stdout, indent=2)
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()